@@ -617,7 +617,8 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
             Box mboxF = amrex::grow(bl_tagged.minimalBox(),1);
             BoxList blFcomp;
             blFcomp.parallelComplementIn(mboxF,bl_tagged);
-            blFcomp.simplify();
+            // Only the region is used, to set tags, so the sweep simplify is fine.
+            blFcomp.simplify(true);
             bl_tagged.clear();
 
             const IntVect& iv = IntVect(AMREX_D_DECL(n_error_buf[levf][0]/ref_ratio[levf][0],
@@ -95,6 +95,7 @@ void
 FluxRegister::clear ()
 {
     BndryRegister::clear();
+    m_reflux_layout = RefluxLayout();
 }
 
 FluxRegister::~FluxRegister () {}
@@ -174,81 +175,136 @@ FluxRegister::CrseInit (const MultiFab& mflx,
                         Real            mult,
                         FrOp            op)
 {
-    BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= mflx.nComp());
-    BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= ncomp);
-
-    const Orientation face_lo(dir,Orientation::low);
-    const Orientation face_hi(dir,Orientation::high);
- 
-    MultiFab mf(mflx.boxArray(),mflx.DistributionMap(),numcomp,0,
-                MFInfo(), mflx.Factory());
-
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (Gpu::notInLaunchRegion())
-#endif    
-    for (MFIter mfi(mflx,TilingIfNotGPU()); mfi.isValid(); ++mfi)
-    {
-	const Box& bx = mfi.tilebox();
-        auto       dfab =   mf.array(mfi);
-        auto const sfab = mflx.const_array(mfi);
-        auto const afab = area.const_array(mfi);
-        AMREX_HOST_DEVICE_PARALLEL_FOR_4D ( bx, numcomp, i, j, k, n,
-        {
-            dfab(i,j,k,n) = sfab(i,j,k,n+srccomp)*mult*afab(i,j,k);
-        });
-    }
-
-    for (int pass = 0; pass < 2; pass++)
-    {
-        const Orientation face = ((pass == 0) ? face_lo : face_hi);
-
-        if (op == FluxRegister::COPY)
-        {
-            bndry[face].copyFrom(mf,0,0,destcomp,numcomp);
-        }
-        else
-        {
-            FabSet fs(bndry[face].boxArray(),bndry[face].DistributionMap(),numcomp);
-
-            fs.setVal(0);
+    Array<MultiFab const*,AMREX_SPACEDIM> fluxes{};
+    Array<MultiFab const*,AMREX_SPACEDIM> areas{};
+    fluxes[dir] = &mflx;
+    areas[dir] = &area;
+    CrseInitFaces({Orientation(dir,Orientation::low), Orientation(dir,Orientation::high)},
+                  fluxes, areas, srccomp, destcomp, numcomp, mult, op);
+}
 
-            fs.copyFrom(mf,0,0,0,numcomp);
+void
+FluxRegister::CrseInit (const MultiFab& mflx,
+                        int             dir,
+                        int             srccomp,
+                        int             destcomp,
+                        int             numcomp,
+                        Real            mult,
+                        FrOp            op)
+{
+    Array<MultiFab const*,AMREX_SPACEDIM> fluxes{};
+    fluxes[dir] = &mflx;
+    CrseInitFaces({Orientation(dir,Orientation::low), Orientation(dir,Orientation::high)},
+                  fluxes, {}, srccomp, destcomp, numcomp, mult, op);
+}
 
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (Gpu::notInLaunchRegion())
-#endif
-            for (FabSetIter mfi(fs); mfi.isValid(); ++mfi)
-            {
-                const Box& bx = mfi.validbox();
-                auto const sfab = fs.const_array(mfi);
-                auto       dfab = bndry[face].array(mfi);
-                AMREX_HOST_DEVICE_PARALLEL_FOR_4D (bx, numcomp, i, j, k, n,
-                {
-                    dfab(i,j,k,n+destcomp) += sfab(i,j,k,n);
-                });
-            }
-        }
+void
+FluxRegister::CrseInit (const Array<MultiFab const*,AMREX_SPACEDIM>& mflx,
+                        const Array<MultiFab const*,AMREX_SPACEDIM>& area,
+                        int             srccomp,
+                        int             destcomp,
+                        int             numcomp,
+                        Real            mult,
+                        FrOp            op)
+{
+    Vector<Orientation> faces;
+    for (OrientationIter fi; fi; ++fi) {
+        faces.push_back(fi());
     }
+    CrseInitFaces(faces, mflx, area, srccomp, destcomp, numcomp, mult, op);
 }
 
 void
-FluxRegister::CrseInit (const MultiFab& mflx,
-                        int             dir,
+FluxRegister::CrseInit (const Array<MultiFab const*,AMREX_SPACEDIM>& mflx,
                         int             srccomp,
                         int             destcomp,
                         int             numcomp,
                         Real            mult,
                         FrOp            op)
 {
-    BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= mflx.nComp());
+    CrseInit(mflx, {}, srccomp, destcomp, numcomp, mult, op);
+}
+
+void
+FluxRegister::CrseInitFaces (Vector<Orientation> const& faces,
+                             const Array<MultiFab const*,AMREX_SPACEDIM>& mflx,
+                             const Array<MultiFab const*,AMREX_SPACEDIM>& area,
+                             int srccomp, int destcomp, int numcomp, Real mult, FrOp op)
+{
+    BL_PROFILE("FluxRegister::CrseInit()");
+
     BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= ncomp);
 
-    MultiFab area(mflx.boxArray(), mflx.DistributionMap(), 1, 0,
-                  MFInfo(), mflx.Factory());
+    // The fluxes and the areas are copied to the registers in one
+    // communication step, and scaled there.
+    const int nfaces = faces.size();
+    Vector<FabSet> fs(nfaces);
+    Vector<FabSet> as(nfaces);
+    FabArrayCommGroup<FArrayBox> fcg;
+    for (int iface = 0; iface < nfaces; ++iface)
+    {
+        const Orientation face = faces[iface];
+        const int dir = face.coordDir();
+
+        BL_ASSERT(mflx[dir] != nullptr);
+        BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= mflx[dir]->nComp());
+
+        fs[iface].define(bndry[face].boxArray(), bndry[face].DistributionMap(), numcomp);
+        fs[iface].setVal(0.0);
+        fcg.addParallelCopy(fs[iface].m_mf, *mflx[dir], srccomp, 0, numcomp,
+                            IntVect(0), IntVect(0));
+        if (area[dir]) {
+            as[iface].define(bndry[face].boxArray(), bndry[face].DistributionMap(), 1);
+            as[iface].setVal(0.0);
+            fcg.addParallelCopy(as[iface].m_mf, *area[dir], 0, 0, 1, IntVect(0), IntVect(0));
+        }
+    }
+    fcg.ParallelCopy();
 
-    area.setVal(1, 0, 1, 0);
+    const bool copy = (op == FluxRegister::COPY);
 
-    CrseInit(mflx,area,dir,srccomp,destcomp,numcomp,mult,op);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    {
+        std::vector< std::pair<int,Box> > isects;
+        for (FabSetIter mfi(bndry[faces[0]]); mfi.isValid(); ++mfi)
+        {
+            for (int iface = 0; iface < nfaces; ++iface)
+            {
+                const int dir = faces[iface].coordDir();
+                const bool has_area = (area[dir] != nullptr);
+                const Box& bx = fs[iface][mfi].box();
+                auto const sfab = fs[iface].const_array(mfi);
+                auto const afab = has_area ? as[iface].const_array(mfi) : Array4<Real const>{};
+                auto       dfab = bndry[faces[iface]].array(mfi);
+                if (copy)
+                {
+                    // As with copyFrom, the register is left alone where
+                    // there are no fluxes.
+                    mflx[dir]->boxArray().intersections(bx, isects);
+                    for (auto const& is : isects)
+                    {
+                        AMREX_HOST_DEVICE_PARALLEL_FOR_4D (is.second, numcomp, i, j, k, n,
+                        {
+                            Real v = sfab(i,j,k,n)*mult;
+                            if (has_area) v *= afab(i,j,k);
+                            dfab(i,j,k,n+destcomp) = v;
+                        });
+                    }
+                }
+                else
+                {
+                    AMREX_HOST_DEVICE_PARALLEL_FOR_4D (bx, numcomp, i, j, k, n,
+                    {
+                        Real v = sfab(i,j,k,n)*mult;
+                        if (has_area) v *= afab(i,j,k);
+                        dfab(i,j,k,n+destcomp) += v;
+                    });
+                }
+            }
+        }
+    }
 }
 
 void
@@ -285,11 +341,13 @@ FluxRegister::CrseAdd (const MultiFab& mflx,
         });
     }
 
-    for (int pass = 0; pass < 2; pass++)
+    FabArrayCommGroup<FArrayBox> fcg;
+    for (const auto& face : {face_lo, face_hi})
     {
-        const Orientation face = ((pass == 0) ? face_lo : face_hi);
-        bndry[face].plusFrom(mf,0,0,destcomp,numcomp,geom.periodicity());
+        fcg.addParallelCopy(bndry[face].m_mf, mf, 0, destcomp, numcomp, IntVect(0), IntVect(0),
+                            geom.periodicity(), FabArrayBase::ADD);
     }
+    fcg.ParallelCopy();
 }
 
 void
@@ -349,6 +407,46 @@ FluxRegister::FineAdd (const MultiFab& mflx,
     }
 }
 
+void
+FluxRegister::FineAdd (const Array<MultiFab const*,AMREX_SPACEDIM>& mflx,
+                       int             srccomp,
+                       int             destcomp,
+                       int             numcomp,
+                       Real            mult)
+{
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(*mflx[0]); mfi.isValid(); ++mfi)
+    {
+        const int k = mfi.index();
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+            FineAdd((*mflx[dir])[mfi],dir,k,srccomp,destcomp,numcomp,mult,RunOn::Gpu);
+        }
+    }
+}
+
+void
+FluxRegister::FineAdd (const Array<MultiFab const*,AMREX_SPACEDIM>& mflx,
+                       const Array<MultiFab const*,AMREX_SPACEDIM>& area,
+                       int             srccomp,
+                       int             destcomp,
+                       int             numcomp,
+                       Real            mult)
+{
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(*mflx[0]); mfi.isValid(); ++mfi)
+    {
+        const int k = mfi.index();
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+            FineAdd((*mflx[dir])[mfi],(*area[dir])[mfi],dir,k,srccomp,destcomp,numcomp,mult,
+                    RunOn::Gpu);
+        }
+    }
+}
+
 void
 FluxRegister::FineAdd (const FArrayBox& flux,
                        int              dir,
@@ -481,11 +579,11 @@ FluxRegister::Reflux (MultiFab&       mf,
 		      int             nc,
 		      const Geometry& geom)
 {
-    for (OrientationIter fi; fi; ++fi)
-    {
-	const Orientation& face = fi();
-        Reflux(mf, volume, face, scale, scomp, dcomp, nc, geom);
+    Vector<Orientation> faces;
+    for (OrientationIter fi; fi; ++fi) {
+        faces.push_back(fi());
     }
+    RefluxFaces(mf, volume, faces, scale, scomp, dcomp, nc, geom);
 }
 
 void
@@ -498,12 +596,8 @@ FluxRegister::Reflux (MultiFab&       mf,
 		      int             nc,
 		      const Geometry& geom)
 {
-    for (int s = 0; s < 2; ++s)
-    {
-        Orientation::Side side = (s==0) ? Orientation::low : Orientation::high;
-	Orientation face(dir, side);
-        Reflux(mf, volume, face, scale, scomp, dcomp, nc, geom);
-    }
+    RefluxFaces(mf, volume, {Orientation(dir,Orientation::low), Orientation(dir,Orientation::high)},
+                scale, scomp, dcomp, nc, geom);
 }
 
 void
@@ -573,6 +667,122 @@ FluxRegister::Reflux (MultiFab& mf, const MultiFab& volume, Orientation face,
     }
 }
 
+void
+FluxRegister::RefluxFaces (MultiFab& mf, const MultiFab& volume, Vector<Orientation> const& faces,
+                           Real scale, int scomp, int dcomp, int nc, const Geometry& geom)
+{
+    BL_PROFILE("FluxRegister::Reflux()");
+
+    const Periodicity& period = geom.periodicity();
+    if (! (m_reflux_layout.crse_ba == mf.boxArray() &&
+           m_reflux_layout.crse_dm == mf.DistributionMap() &&
+           m_reflux_layout.period == period))
+    {
+        buildRefluxLayout(mf.boxArray(), mf.DistributionMap(), period);
+    }
+    auto const& layout = m_reflux_layout;
+
+    // One communication step for all faces.  The registers go to the faces
+    // of the coarse cells they correct, on the processes that own the cells.
+    const int nfaces = faces.size();
+    Vector<MultiFab> flux(nfaces);
+    FabArrayCommGroup<FArrayBox> fcg;
+    for (int iface = 0; iface < nfaces; ++iface)
+    {
+        const Orientation face = faces[iface];
+        if (layout.ba[face].empty()) continue;
+        flux[iface].define(layout.ba[face], layout.dm[face], nc, 0, MFInfo(), FArrayBoxFactory());
+        fcg.addParallelCopy(flux[iface], bndry[face].m_mf, scomp, 0, nc, IntVect(0), IntVect(0),
+                            period);
+    }
+    fcg.ParallelCopy();
+
+    // The pieces of each local coarse box, in the order of the faces.
+    Vector<Vector<std::pair<int,int> > > pieces(mf.local_size());
+    for (int iface = 0; iface < nfaces; ++iface)
+    {
+        const Orientation face = faces[iface];
+        if (layout.ba[face].empty()) continue;
+        for (int li = 0, N = flux[iface].local_size(); li < N; ++li) {
+            const int k = flux[iface].IndexArray()[li];
+            pieces[mf.localindex(layout.crse_index[face][k])].emplace_back(iface, li);
+        }
+    }
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(dynamic) if (Gpu::notInLaunchRegion())
+#endif
+    for (int lj = 0; lj < mf.local_size(); ++lj)
+    {
+        Array4<Real> const& sfab = mf.atLocalIdx(lj).array();
+        Array4<Real const> const& vfab = volume.atLocalIdx(lj).const_array();
+        for (auto const& p : pieces[lj])
+        {
+            const Orientation face = faces[p.first];
+            const FArrayBox& ffab = flux[p.first].atLocalIdx(p.second);
+            Array4<Real const> const& farr = ffab.const_array();
+            // The corrected cells are on the low side of the faces for a
+            // low face of the fine grids.
+            Box bx(ffab.box().smallEnd(), ffab.box().bigEnd());
+            if (face.isLow()) bx.shift(face.coordDir(), -1);
+            AMREX_LAUNCH_HOST_DEVICE_LAMBDA (bx, tbx,
+            {
+                fluxreg_reflux(tbx, sfab, dcomp, farr, vfab, nc, scale, face);
+            });
+        }
+    }
+}
+
+void
+FluxRegister::buildRefluxLayout (const BoxArray& crse_ba, const DistributionMapping& crse_dm,
+                                 const Periodicity& period)
+{
+    BL_PROFILE("FluxRegister::buildRefluxLayout()");
+
+    auto& layout = m_reflux_layout;
+    layout.crse_ba = crse_ba;
+    layout.crse_dm = crse_dm;
+    layout.period = period;
+
+    const std::vector<IntVect>& pshifts = period.shiftIntVect();
+    std::vector<std::pair<int,Box> > isects;
+
+    for (OrientationIter fi; fi; ++fi)
+    {
+        const Orientation face = fi();
+        const int dir = face.coordDir();
+        const BoxArray& rba = bndry[face].boxArray();
+
+        BoxList bl(rba.ixType());
+        Vector<int> pmap;
+        Vector<int>& crse_index = layout.crse_index[face];
+        crse_index.clear();
+
+        for (int i = 0, N = rba.size(); i < N; ++i)
+        {
+            // The coarse cells next to the register, outside the fine grid.
+            const Box& rbx = rba[i];
+            Box cells(rbx.smallEnd(), rbx.bigEnd());
+            if (face.isLow()) cells.shift(dir, -1);
+
+            for (const auto& iv : pshifts)
+            {
+                crse_ba.intersections(cells+iv, isects);
+                for (const auto& is : isects)
+                {
+                    bl.push_back(face.isLow() ? amrex::bdryHi(is.second, dir)
+                                              : amrex::bdryLo(is.second, dir));
+                    pmap.push_back(crse_dm[is.first]);
+                    crse_index.push_back(is.first);
+                }
+            }
+        }
+
+        layout.ba[face] = BoxArray(std::move(bl));
+        layout.dm[face] = pmap.empty() ? DistributionMapping() : DistributionMapping(std::move(pmap));
+    }
+}
+
 void
 FluxRegister::ClearInternalBorders (const Geometry& geom)
 {
@@ -1,4 +1,5 @@
 
+#include <algorithm>
 #include <climits>
 
 #include <AMReX_FArrayBox.H>
@@ -382,13 +383,128 @@ Interpolater::GetBCArray (const Vector<BCRec>& bcr)
     return bc;
 }
 
+namespace {
+    bool s_stencil_finalize_registered = false;
+
+    Vector<CellConservativeLinear*>& stencil_cache_users ()
+    {
+        static Vector<CellConservativeLinear*> users;
+        return users;
+    }
+
+    Vector<int>
+    ccinterp_compute_cidx (const Box& cbx, const IntVect& ratio)
+    {
+        const Box& fbx = amrex::refine(cbx,ratio);
+        Vector<int> cidx;
+        cidx.reserve(fbx.length().sum());
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            for (int i = fbx.smallEnd(idim); i <= fbx.bigEnd(idim); ++i) {
+                cidx.push_back(amrex::coarsen(i,ratio[idim]));
+            }
+        }
+        return cidx;
+    }
+}
+
 CellConservativeLinear::CellConservativeLinear (bool do_linear_limiting_)
 {
     do_linear_limiting = do_linear_limiting_;
 }
 
 CellConservativeLinear::~CellConservativeLinear ()
-{}
+{
+    if (m_registered) {
+        auto& users = stencil_cache_users();
+        users.erase(std::remove(users.begin(), users.end(), this), users.end());
+        clearStencilCache();
+    }
+}
+
+void
+CellConservativeLinear::setStencilCaching (bool a_cache)
+{
+    m_cache_stencils = a_cache;
+    if (!a_cache) {
+        clearStencilCache();
+    } else if (!m_registered) {
+        stencil_cache_users().push_back(this);
+        m_registered = true;
+        if (!s_stencil_finalize_registered) {
+            amrex::ExecOnFinalize(CellConservativeLinear::Finalize);
+            s_stencil_finalize_registered = true;
+        }
+    }
+}
+
+void
+CellConservativeLinear::clearStencilCache ()
+{
+    if (!m_stencil_cache.empty()) {
+        // Kernels launched with the cached stencils may still be running.
+        Gpu::streamSynchronize();
+        m_stencil_cache.clear();
+    }
+}
+
+void
+CellConservativeLinear::Finalize ()
+{
+    for (auto* p : stencil_cache_users()) {
+        p->clearStencilCache();
+        p->m_registered = false;
+    }
+    stencil_cache_users().clear();
+    s_stencil_finalize_registered = false;
+}
+
+void
+CellConservativeLinear::buildStencil (Stencil& stencil, const Box& cslope_bx, const IntVect& ratio,
+                                      const Geometry& crse_geom, const Geometry& fine_geom) const
+{
+    stencil.voff = amrex::ccinterp_compute_voff(cslope_bx, ratio, crse_geom, fine_geom);
+    stencil.cidx = ccinterp_compute_cidx(cslope_bx, ratio);
+
+#ifdef AMREX_USE_GPU
+    stencil.d_voff.resize(stencil.voff.size());
+    stencil.d_cidx.resize(stencil.cidx.size());
+    Gpu::copyAsync(Gpu::hostToDevice, stencil.voff.begin(), stencil.voff.end(), stencil.d_voff.begin());
+    Gpu::copyAsync(Gpu::hostToDevice, stencil.cidx.begin(), stencil.cidx.end(), stencil.d_cidx.begin());
+    Gpu::streamSynchronize();
+#endif
+}
+
+const CellConservativeLinear::Stencil&
+CellConservativeLinear::getStencil (const Box& cslope_bx, const IntVect& ratio,
+                                    const Geometry& crse_geom, const Geometry& fine_geom)
+{
+    StencilKey key;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        key.first[idim                 ] = cslope_bx.smallEnd(idim);
+        key.first[idim+  AMREX_SPACEDIM] = cslope_bx.bigEnd(idim);
+        key.first[idim+2*AMREX_SPACEDIM] = ratio[idim];
+        key.second[idim                 ] = crse_geom.Offset(idim);
+        key.second[idim+  AMREX_SPACEDIM] = crse_geom.CellSize(idim);
+        key.second[idim+2*AMREX_SPACEDIM] = fine_geom.Offset(idim);
+        key.second[idim+3*AMREX_SPACEDIM] = fine_geom.CellSize(idim);
+    }
+    key.first[3*AMREX_SPACEDIM] = static_cast<int>(crse_geom.Coord());
+
+    Stencil* stencil = nullptr;
+#ifdef AMREX_USE_OMP
+#pragma omp critical (amrex_interp_stencil_cache)
+#endif
+    {
+        auto found = m_stencil_cache.find(key);
+        if (found == m_stencil_cache.end()) {
+            stencil = &m_stencil_cache[key];
+            buildStencil(*stencil, cslope_bx, ratio, crse_geom, fine_geom);
+        } else {
+            stencil = &(found->second);
+        }
+    }
+    return *stencil;
+}
 
 Box
 CellConservativeLinear::CoarseBox (const Box&     fine,
@@ -454,50 +570,69 @@ CellConservativeLinear::interp (const FArrayBox& crse,
     if (run_on_gpu) cceli = ccfab.elixir();
     Array4<Real> const& ccarr = ccfab.array();
 
-    const Vector<Real>& vec_voff = amrex::ccinterp_compute_voff(cslope_bx, ratio, crse_geom, fine_geom);
+    // The stencil (offsets and coarse indices of the fine cells) is either
+    // taken from the cache or built for this call only.
+    Vector<Real> vec_voff;
+    Vector<int> vec_cidx;
+    if (!m_cache_stencils) {
+        vec_voff = amrex::ccinterp_compute_voff(cslope_bx, ratio, crse_geom, fine_geom);
+        vec_cidx = ccinterp_compute_cidx(cslope_bx, ratio);
+    }
 
-    AsyncArray<Real> async_voff(vec_voff.data(), (run_on_gpu) ? vec_voff.size() : 0);
-    Real const* voff = (run_on_gpu) ? async_voff.data() : vec_voff.data();
+    const bool copy_stencil = run_on_gpu && !m_cache_stencils;
+    AsyncArray<Real> async_voff(vec_voff.data(), (copy_stencil) ? vec_voff.size() : 0);
+    AsyncArray<int> async_cidx(vec_cidx.data(), (copy_stencil) ? vec_cidx.size() : 0);
+    Real const* voff = (copy_stencil) ? async_voff.data() : vec_voff.data();
+    int const* cidx = (copy_stencil) ? async_cidx.data() : vec_cidx.data();
+
+    if (m_cache_stencils) {
+        const Stencil& stencil = getStencil(cslope_bx, ratio, crse_geom, fine_geom);
+#ifdef AMREX_USE_GPU
+        voff = (run_on_gpu) ? stencil.d_voff.data() : stencil.voff.data();
+        cidx = (run_on_gpu) ? stencil.d_cidx.data() : stencil.cidx.data();
+#else
+        voff = stencil.voff.data();
+        cidx = stencil.cidx.data();
+#endif
+    }
 
     if (do_linear_limiting) {
         AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG ( runon, cslope_bx, tbx,
         {
             amrex::cellconslin_slopes_linlim(tbx, ccarr, crsearr, crse_comp, ncomp, bcrp);
         });
-
-        AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG ( runon, fine_region, tbx,
-        {
-            amrex::cellconslin_interp(tbx, finearr, fine_comp, ncomp, ccarr, crsearr, crse_comp,
-                                      voff, ratio);
-        });
     } else {
-        const Box& fslope_bx = amrex::refine(cslope_bx,ratio);
-        FArrayBox fafab(fslope_bx, ncomp);
-        Elixir faeli;
-        if (run_on_gpu) faeli = fafab.elixir();
-        Array4<Real> const& faarr = fafab.array();
-
         AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (runon, cslope_bx, tbx,
         {
             amrex::cellconslin_slopes_mclim(tbx, ccarr, crsearr, crse_comp, ncomp, bcrp);
         });
 
-        AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (runon, fslope_bx, tbx,
-        {
-            amrex::cellconslin_fine_alpha(tbx, faarr, ccarr, ncomp, voff, ratio);
-        });
-
-        AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (runon, cslope_bx, tbx,
-        {
-            amrex::cellconslin_slopes_mmlim(tbx, ccarr, faarr, ncomp, ratio);
-        });
-
-        AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (runon, fine_region, tbx,
-        {
-            amrex::cellconslin_interp(tbx, finearr, fine_comp, ncomp, ccarr, crsearr, crse_comp,
-                                      voff, ratio);
-        });
+        if (run_on_gpu) {
+            // One thread per fine cell for the limiter on GPUs.
+            const Box& fslope_bx = amrex::refine(cslope_bx,ratio);
+            FArrayBox fafab(fslope_bx, ncomp);
+            Elixir faeli = fafab.elixir();
+            Array4<Real> const& faarr = fafab.array();
+
+            AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (runon, fslope_bx, tbx,
+            {
+                amrex::cellconslin_fine_alpha(tbx, faarr, ccarr, ncomp, voff, ratio);
+            });
+
+            AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (runon, cslope_bx, tbx,
+            {
+                amrex::cellconslin_slopes_mmlim(tbx, ccarr, faarr, ncomp, ratio);
+            });
+        } else {
+            amrex::cellconslin_slopes_mmlim_stencil(cslope_bx, ccarr, ncomp, voff, ratio);
+        }
     }
+
+    AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG ( runon, fine_region, tbx,
+    {
+        amrex::cellconslin_interp_stencil(tbx, finearr, fine_comp, ncomp, ccarr, crsearr, crse_comp,
+                                          voff, cidx, ratio);
+    });
 }
 
 #ifndef BL_NO_FORT
@@ -1044,36 +1179,36 @@ FaceDivFree::interp_arr (Array<FArrayBox*, AMREX_SPACEDIM> const& crse,
     AMREX_LAUNCH_HOST_DEVICE_LAMBDA_DIM_FLAG(runon,
               amrex::convert(c_fine_region,types[0]), bx0,
               {
-                  AMREX_LOOP_3D(bx0, i, j, k,
+                  for (int n=0; n<ncomp; ++n)
                   {
-                      for (int n=0; n<ncomp; ++n)
+                      AMREX_LOOP_3D(bx0, i, j, k,
                       {
                           amrex::facediv_face_interp<Real> (i,j,k,crse_comp+n,fine_comp+n, 0,
                                                             crsearr[0], finearr[0], maskarr[0], ratio);
-                      }
-                  });
+                      });
+                  }
               },
               amrex::convert(c_fine_region,types[1]), bx1,
               {
-                  AMREX_LOOP_3D(bx1, i, j, k,
+                  for (int n=0; n<ncomp; ++n)
                   {
-                      for (int n=0; n<ncomp; ++n)
+                      AMREX_LOOP_3D(bx1, i, j, k,
                       {
                           amrex::facediv_face_interp<Real> (i,j,k,crse_comp+n,fine_comp+n, 1,
                                                             crsearr[1], finearr[1], maskarr[1], ratio);
-                      }
-                  });
+                      });
+                  }
               },
               amrex::convert(c_fine_region,types[2]), bx2,
               {
-                  AMREX_LOOP_3D(bx2, i, j, k,
+                  for (int n=0; n<ncomp; ++n)
                   {
-                      for (int n=0; n<ncomp; ++n)
+                      AMREX_LOOP_3D(bx2, i, j, k,
                       {
                           amrex::facediv_face_interp<Real> (i,j,k,crse_comp+n,fine_comp+n, 2,
                                                             crsearr[2], finearr[2], maskarr[2], ratio);
-                      }
-                  });
+                      });
+                  }
               });
 
     AMREX_HOST_DEVICE_PARALLEL_FOR_4D_FLAG(runon,c_fine_region,ncomp,i,j,k,n,
@@ -142,4 +142,15 @@ void Notify ()
 #endif
 }
 
+void Barrier ()
+{
+#ifdef AMREX_USE_MPI
+    if (s_info.nspots > 1) {
+        MPI_Request req = ParallelDescriptor::Abarrier(s_comm).req();
+        MPI_Status stat;
+        ParallelDescriptor::Wait(req, stat);
+    }
+#endif
+}
+
 }}
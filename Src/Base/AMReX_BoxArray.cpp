@@ -4,6 +4,7 @@
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_Utility.H>
 #include <AMReX_MFIter.H>
+#include <AMReX_ParmParse.H>
 #include <AMReX_BaseFab.H>
 
 #ifdef AMREX_MEM_PROFILING
@@ -12,6 +13,9 @@
 
 #include <AMReX_OpenMP.H>
 
+#include <algorithm>
+#include <limits>
+
 namespace amrex {
 
 #ifdef AMREX_MEM_PROFILING
@@ -24,10 +28,276 @@ Long BARef::total_hash_bytes_hwm = 0L;
 #endif
 
 bool    BARef::initialized = false;
+Long    BARef::compress_min_size = 100000;
 bool BoxArray::initialized = false;
 
 namespace {
     const int bl_ignore_max = 100000;
+
+    /**
+    * \brief Bins the boxes by size and hashes each bin.
+    *
+    * A box is in size class c if its maximum extent is in (2^(c-1),2^c].
+    * The bins are hashed in parallel.
+    */
+    Vector<BARef::HashBin>
+    make_hash_bins (const Vector<Box>& abox)
+    {
+        const int N = abox.size();
+        constexpr int nclasses = 32;
+
+        Vector<int> sizeclass(N);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for
+#endif
+        for (int i = 0; i < N; ++i) {
+            Box bx = abox[i];
+            bx.normalize();
+            const int maxext = bx.size().max();
+            int c = 0;
+            while (c < nclasses-1 && (1 << c) < maxext) { ++c; }
+            sizeclass[i] = c;
+        }
+
+        Vector<int> binid(nclasses, -1);
+        for (int i = 0; i < N; ++i) {
+            binid[sizeclass[i]] = 0;
+        }
+        int nbins = 0;
+        for (auto& ib : binid) {
+            if (ib == 0) { ib = nbins++; }
+        }
+
+        Vector<BARef::HashBin> bins(nbins);
+        Vector<std::vector<int> > members(nbins);
+        Vector<IntVect> smlo(nbins, IntVect(std::numeric_limits<int>::max()));
+        Vector<IntVect> smhi(nbins, IntVect(std::numeric_limits<int>::lowest()));
+        for (auto& bin : bins) {
+            bin.crsn = IntVect::TheUnitVector();
+        }
+        for (int i = 0; i < N; ++i) {
+            const int ib = binid[sizeclass[i]];
+            Box bx = abox[i];
+            bx.normalize();
+            bins[ib].crsn = amrex::max(bins[ib].crsn, bx.size());
+            smlo[ib] = amrex::min(smlo[ib], abox[i].smallEnd());
+            smhi[ib] = amrex::max(smhi[ib], abox[i].smallEnd());
+            members[ib].push_back(i);
+        }
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+        for (int ib = 0; ib < nbins; ++ib)
+        {
+            auto& bin = bins[ib];
+            bin.bbox = Box(amrex::coarsen(smlo[ib],bin.crsn),
+                           amrex::coarsen(smhi[ib],bin.crsn));
+            const int nmembers = members[ib].size();
+            const Long ncells = bin.bbox.numPts();
+            if (ncells <= 2*static_cast<Long>(nmembers))
+            {
+                bin.offsets.resize(ncells+1, 0);
+                for (const int i : members[ib]) {
+                    ++bin.offsets[bin.bbox.index(amrex::coarsen(abox[i].smallEnd(),bin.crsn))+1];
+                }
+                for (Long c = 0; c < ncells; ++c) {
+                    bin.offsets[c+1] += bin.offsets[c];
+                }
+                Vector<int> pos(bin.offsets.begin(), bin.offsets.end()-1);
+                bin.indices.resize(nmembers);
+                for (const int i : members[ib]) {
+                    bin.indices[pos[bin.bbox.index(amrex::coarsen(abox[i].smallEnd(),bin.crsn))]++] = i;
+                }
+            }
+            else
+            {
+                bin.hash.reserve(nmembers);
+                for (const int i : members[ib]) {
+                    bin.hash[amrex::coarsen(abox[i].smallEnd(),bin.crsn)].push_back(i);
+                }
+            }
+        }
+
+        return bins;
+    }
+
+    /**
+    * \brief Adds box b with index i to the first hashed bin whose boxes are
+    * not smaller than b.  Dense bins are not modified.
+    */
+    void
+    add_to_hash_bins (Vector<BARef::HashBin>& bins, const Box& b, int i)
+    {
+        Box bx = b;
+        bx.normalize();
+        auto it = std::find_if(bins.begin(), bins.end(),
+                               [&] (BARef::HashBin const& bin) { return bx.size().allLE(bin.crsn); });
+        IntVect crsn = (it == bins.end()) ? bx.size() : it->crsn;
+        it = std::find_if(it, bins.end(),
+                          [&] (BARef::HashBin const& bin) { return !bin.isDense() && bin.crsn == crsn; });
+        if (it == bins.end()) {
+            bins.emplace_back();
+            it = bins.end()-1;
+            it->crsn = crsn;
+            it->bbox = Box(amrex::coarsen(b.smallEnd(),it->crsn),
+                           amrex::coarsen(b.smallEnd(),it->crsn));
+        }
+        const IntVect& key = amrex::coarsen(b.smallEnd(),it->crsn);
+        it->hash[key].push_back(i);
+        it->bbox.setSmall(amrex::min(it->bbox.smallEnd(),key));
+        it->bbox.setBig  (amrex::max(it->bbox.bigEnd()  ,key));
+    }
+
+    /**
+    * \brief Calls f(index) for the hashed boxes that may intersect gbx.
+    *
+    * These are the boxes whose coarsened small end is in the coarsened gbx or
+    * one below it.  Stops if f returns true.
+    */
+    template <class F>
+    void
+    for_each_hashed_box (const Vector<BARef::HashBin>& bins, const Box& gbx, F&& f)
+    {
+        for (const auto& bin : bins)
+        {
+            const Box& cgbx = amrex::coarsen(gbx,bin.crsn);
+            const IntVect& sm = amrex::max(cgbx.smallEnd()-1, bin.bbox.smallEnd());
+            const IntVect& bg = amrex::min(cgbx.bigEnd(),     bin.bbox.bigEnd());
+            if (!sm.allLE(bg)) continue;
+
+            Box cbx(sm,bg);
+            if (bin.isDense())
+            {
+                for (IntVect iv = sm; iv <= bg; cbx.next(iv))
+                {
+                    const Long c = bin.bbox.index(iv);
+                    for (int n = bin.offsets[c]; n < bin.offsets[c+1]; ++n) {
+                        if (f(bin.indices[n])) return;
+                    }
+                }
+            }
+            else
+            {
+                auto TheEnd = bin.hash.cend();
+                for (IntVect iv = sm; iv <= bg; cbx.next(iv))
+                {
+                    auto it = bin.hash.find(iv);
+                    if (it != TheEnd) {
+                        for (const int index : it->second) {
+                            if (f(index)) return;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+    * \brief Calls f(index) for the boxes that may intersect gbx, which is in
+    * the index space of the stored boxes.  Stops if f returns true.
+    */
+    template <class F>
+    void
+    for_each_candidate_box (const BARef& ref, const Box& gbx, const IntVect& crse_ratio, F&& f)
+    {
+        if (ref.isCompressed()) {
+            // gbx was refined as a box of its own type, so its big end may
+            // be the first fine cell of a coarse cell.
+            ref.m_lattice.forEachBox(Box(gbx.smallEnd(), gbx.bigEnd()+(crse_ratio-1)), f);
+        } else {
+            for_each_hashed_box(ref.hash, gbx, f);
+        }
+    }
+}
+
+BoxLattice
+BoxLattice::make (const Vector<Box>& abox)
+{
+    BoxLattice lat;
+    const Long N = abox.size();
+    if (N < 2) return lat;
+
+    // The slabs in direction d are read off the boxes whose slabs in the
+    // slower directions are those of the first box.
+    const Box& b0 = abox[0];
+    Long stride = 1;
+    for (int d = 0; d < AMREX_SPACEDIM; ++d)
+    {
+        auto& c = lat.cuts[d];
+        c.push_back(b0.smallEnd(d));
+        for (Long i = 0; i < N; i += stride)
+        {
+            const Box& b = abox[i];
+            bool same_row = true;
+            for (int dd = d+1; dd < AMREX_SPACEDIM; ++dd) {
+                same_row = same_row && b.smallEnd(dd) == b0.smallEnd(dd);
+            }
+            if (!same_row) break;
+            if (b.smallEnd(d) != c.back() || b.bigEnd(d) < b.smallEnd(d)) {
+                return BoxLattice();
+            }
+            c.push_back(b.bigEnd(d)+1);
+        }
+        stride *= static_cast<Long>(c.size()-1);
+    }
+
+    if (lat.size() != N) return BoxLattice();
+
+    bool is_lattice = true;
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for reduction(&&:is_lattice)
+#endif
+    for (Long i = 0; i < N; ++i) {
+        is_lattice = is_lattice && abox[i] == lat.box(i);
+    }
+    return is_lattice ? lat : BoxLattice();
+}
+
+void
+BoxLattice::refine (const IntVect& ratio) noexcept
+{
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        for (auto& c : cuts[d]) {
+            c *= ratio[d];
+        }
+    }
+}
+
+void
+BoxLattice::shift (const IntVect& iv) noexcept
+{
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        for (auto& c : cuts[d]) {
+            c += iv[d];
+        }
+    }
+}
+
+bool
+BoxLattice::coarsen (const IntVect& ratio) noexcept
+{
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        for (auto c : cuts[d]) {
+            if (c % ratio[d] != 0) return false;
+        }
+    }
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        for (auto& c : cuts[d]) {
+            c /= ratio[d];
+        }
+    }
+    return true;
+}
+
+Long
+BoxLattice::bytes () const
+{
+    Long b = 0;
+    for (const auto& c : cuts) {
+        b += amrex::bytesOf(c);
+    }
+    return b;
 }
 
 BARef::BARef () 
@@ -73,7 +343,8 @@ BARef::BARef (std::istream& is)
 }
 
 BARef::BARef (const BARef& rhs) 
-    : m_abox(rhs.m_abox) // don't copy hash
+    : m_abox(rhs.m_abox), // don't copy hash
+      m_lattice(rhs.m_lattice)
 {
 #ifdef AMREX_MEM_PROFILING
     updateMemoryUsage_box(1);
@@ -177,7 +448,7 @@ BARef::resize (Long n) {
     updateMemoryUsage_box(-1);
     updateMemoryUsage_hash(-1);
 #endif
-    m_abox.resize(n);
+    boxes().resize(n);
     hash.clear();
     has_hashmap = false;
 #ifdef AMREX_MEM_PROFILING
@@ -185,12 +456,78 @@ BARef::resize (Long n) {
 #endif
 }
 
+void
+BARef::compress ()
+{
+    if (static_cast<Long>(m_abox.size()) < compress_min_size) return;
+
+    BoxLattice lat = BoxLattice::make(m_abox);
+    if (!lat.empty() && lat.bytes() < amrex::bytesOf(m_abox))
+    {
+#ifdef AMREX_MEM_PROFILING
+        updateMemoryUsage_box(-1);
+#endif
+        m_lattice = std::move(lat);
+        Vector<Box>().swap(m_abox);
+#ifdef AMREX_MEM_PROFILING
+        updateMemoryUsage_box(1);
+#endif
+    }
+}
+
+Vector<Box>&
+BARef::boxes ()
+{
+    if (isCompressed())
+    {
+#ifdef AMREX_MEM_PROFILING
+        updateMemoryUsage_box(-1);
+#endif
+        const Long N = m_lattice.size();
+        m_abox.resize(N);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for
+#endif
+        for (Long i = 0; i < N; ++i) {
+            m_abox[i] = m_lattice.box(i);
+        }
+        m_lattice = BoxLattice();
+#ifdef AMREX_MEM_PROFILING
+        updateMemoryUsage_box(1);
+#endif
+    }
+    return m_abox;
+}
+
+Long
+BARef::boxBytes () const
+{
+    return amrex::bytesOf(m_abox) + m_lattice.bytes();
+}
+
+bool
+BARef::operator== (const BARef& rhs) const noexcept
+{
+    if (isCompressed() && rhs.isCompressed()) {
+        return m_lattice == rhs.m_lattice;
+    } else if (!isCompressed() && !rhs.isCompressed()) {
+        return m_abox == rhs.m_abox;
+    } else {
+        const Long N = size();
+        if (N != rhs.size()) return false;
+        for (Long i = 0; i < N; ++i) {
+            if ((*this)[i] != rhs[i]) return false;
+        }
+        return true;
+    }
+}
+
 #ifdef AMREX_MEM_PROFILING
 void
 BARef::updateMemoryUsage_box (int s)
 {
-    if (m_abox.size() > 1) {
-	Long b = amrex::bytesOf(m_abox);
+    if (size() > 1) {
+	Long b = boxBytes();
 	if (s > 0) {
 	    total_box_bytes += b;
 	    total_box_bytes_hwm = std::max(total_box_bytes_hwm, total_box_bytes);
@@ -207,11 +544,7 @@ void
 BARef::updateMemoryUsage_hash (int s)
 {
     if (hash.size() > 0) {
-	Long b = sizeof(hash);
-	for (const auto& x: hash) {
-	    b += amrex::gcc_map_node_extra_bytes
-		+ sizeof(IntVect) + amrex::bytesOf(x.second);
-	}
+	Long b = hashBytes();
 	if (s > 0) {
 	    total_hash_bytes += b;
 	    total_hash_bytes_hwm = std::max(total_hash_bytes_hwm, total_hash_bytes);
@@ -222,11 +555,29 @@ BARef::updateMemoryUsage_hash (int s)
 }
 #endif
 
+Long
+BARef::hashBytes () const
+{
+    Long b = sizeof(hash);
+    for (const auto& bin : hash) {
+        b += sizeof(bin) + amrex::bytesOf(bin.offsets) + amrex::bytesOf(bin.indices);
+        for (const auto& x: bin.hash) {
+            b += amrex::gcc_map_node_extra_bytes
+                + sizeof(IntVect) + amrex::bytesOf(x.second);
+        }
+    }
+    return b;
+}
+
 void
 BARef::Initialize ()
 {
     if (!initialized) {
 	initialized = true;
+
+        ParmParse pp("boxarray");
+        pp.query("compress_min_size", compress_min_size);
+
 #ifdef AMREX_MEM_PROFILING
 	MemProfiler::add("BoxArray", std::function<MemProfiler::MemInfo()>
 			 ([] () -> MemProfiler::MemInfo {
@@ -390,7 +741,7 @@ BoxArray::numPts () const noexcept
 {
     Long result = 0;
     const int N = size();
-    auto const& bxs = this->m_ref->m_abox;
+    auto const& bxs = *m_ref;
     if (m_bat.is_null()) {
 #ifdef AMREX_USE_OMP
 #pragma omp parallel for reduction(+:result)
@@ -427,7 +778,7 @@ BoxArray::d_numPts () const noexcept
 {
     double result = 0;
     const int N = size();
-    auto const& bxs = this->m_ref->m_abox;
+    auto const& bxs = *m_ref;
     if (m_bat.is_null()) {
 #ifdef AMREX_USE_OMP
 #pragma omp parallel for reduction(+:result)
@@ -466,8 +817,8 @@ BoxArray::readFrom (std::istream& is)
     clear();
     int ndims;
     m_ref->define(is, ndims);
-    if (! m_ref->m_abox.empty()) {
-        m_bat = BATransformer(m_ref->m_abox[0].ixType());
+    if (! empty()) {
+        m_bat = BATransformer((*m_ref)[0].ixType());
         type_update();
     }
     return ndims;
@@ -482,7 +833,7 @@ BoxArray::writeOn (std::ostream& os) const
     os << '(' << size() << ' ' << 0 << '\n';
 
     const int N = size();
-    auto const& bxs = this->m_ref->m_abox;
+    auto const& bxs = *m_ref;
     if (m_bat.is_null()) {
         for (int i = 0; i < N; ++i) {
             os << bxs[i] << '\n';
@@ -511,7 +862,7 @@ bool
 BoxArray::operator== (const BoxArray& rhs) const noexcept
 {
     return m_bat == rhs.m_bat &&
-        (m_ref == rhs.m_ref || m_ref->m_abox == rhs.m_ref->m_abox);
+        (m_ref == rhs.m_ref || *m_ref == *rhs.m_ref);
 }
 
 bool
@@ -540,7 +891,7 @@ bool
 BoxArray::CellEqual (const BoxArray& rhs) const noexcept
 {
     return crseRatio() == rhs.crseRatio()
-        && (m_ref == rhs.m_ref || m_ref->m_abox == rhs.m_ref->m_abox);
+        && (m_ref == rhs.m_ref || *m_ref == *rhs.m_ref);
 }
 
 BoxArray&
@@ -579,13 +930,19 @@ BoxArray::refine (const IntVect& iv)
 {
     uniqify();
 
-    const int N = m_ref->m_abox.size();
+    if (m_ref->isCompressed()) {
+        m_ref->m_lattice.refine(iv);
+        return *this;
+    }
+
+    auto& abox = m_ref->boxes();
+    const int N = abox.size();
 #ifdef AMREX_USE_OMP
 #pragma omp parallel for
 #endif
     for (int i = 0; i < N; i++) {
-	BL_ASSERT(m_ref->m_abox[i].ok());
-        m_ref->m_abox[i].refine(iv);
+	BL_ASSERT(abox[i].ok());
+        abox[i].refine(iv);
     }
     return *this;
 }
@@ -606,7 +963,7 @@ BoxArray::coarsenable(const IntVect& refinement_ratio, int min_width) const
     bool res = first.coarsenable(refinement_ratio,min_width);
     if (res == false) return false;
 
-    auto const& bxs = this->m_ref->m_abox;
+    auto const& bxs = *m_ref;
     if (m_bat.is_null()) {
 #ifdef AMREX_USE_OMP
 #pragma omp parallel for reduction(&&:res)
@@ -665,12 +1022,13 @@ BoxArray::growcoarsen (IntVect const& ngrow, const IntVect& iv)
 {
     uniqify();
 
-    const int N = m_ref->m_abox.size();
+    auto& abox = m_ref->boxes();
+    const int N = abox.size();
 #ifdef AMREX_USE_OMP
 #pragma omp parallel for
 #endif
     for (int i = 0; i < N; i++) {
-        m_ref->m_abox[i].grow(ngrow).coarsen(iv);
+        abox[i].grow(ngrow).coarsen(iv);
     }
     return *this;
 }
@@ -680,12 +1038,13 @@ BoxArray::grow (int n)
 {
     uniqify();
 
-    const int N = m_ref->m_abox.size();
+    auto& abox = m_ref->boxes();
+    const int N = abox.size();
 #ifdef AMREX_USE_OMP
 #pragma omp parallel for
 #endif
     for (int i = 0; i < N; i++) {
-        m_ref->m_abox[i].grow(n);
+        abox[i].grow(n);
     }
     return *this;
 }
@@ -695,12 +1054,13 @@ BoxArray::grow (const IntVect& iv)
 {
     uniqify();
 
-    const int N = m_ref->m_abox.size();
+    auto& abox = m_ref->boxes();
+    const int N = abox.size();
 #ifdef AMREX_USE_OMP
 #pragma omp parallel for
 #endif
     for (int i = 0; i < N; i++) {
-        m_ref->m_abox[i].grow(iv);
+        abox[i].grow(iv);
     }
     return *this;
 }
@@ -711,12 +1071,13 @@ BoxArray::grow (int dir,
 {
     uniqify();
 
-    const int N = m_ref->m_abox.size();
+    auto& abox = m_ref->boxes();
+    const int N = abox.size();
 #ifdef AMREX_USE_OMP
 #pragma omp parallel for
 #endif
     for (int i = 0; i < N; i++) {
-        m_ref->m_abox[i].grow(dir, n_cell);
+        abox[i].grow(dir, n_cell);
     }
     return *this;
 }
@@ -727,12 +1088,13 @@ BoxArray::growLo (int dir,
 {
     uniqify();
 
-    const int N = m_ref->m_abox.size();
+    auto& abox = m_ref->boxes();
+    const int N = abox.size();
 #ifdef AMREX_USE_OMP
 #pragma omp parallel for
 #endif
     for (int i = 0; i < N; i++) {
-        m_ref->m_abox[i].growLo(dir, n_cell);
+        abox[i].growLo(dir, n_cell);
     }
     return *this;
 }
@@ -743,12 +1105,13 @@ BoxArray::growHi (int dir,
 {
     uniqify();
 
-    const int N = m_ref->m_abox.size();
+    auto& abox = m_ref->boxes();
+    const int N = abox.size();
 #ifdef AMREX_USE_OMP
 #pragma omp parallel for
 #endif
     for (int i = 0; i < N; i++) {
-        m_ref->m_abox[i].growHi(dir, n_cell);
+        abox[i].growHi(dir, n_cell);
     }
     return *this;
 }
@@ -805,6 +1168,7 @@ BoxArray::convert (Box (*fp)(const Box&))
     const int N = size();
     if (N > 0) {
         uniqify();
+        m_ref->boxes(); // set() below must not expand a lattice in parallel
 
 #ifdef AMREX_USE_OMP
 #pragma omp parallel for
@@ -822,12 +1186,18 @@ BoxArray::shift (int dir,
 {
     uniqify();
 
-    const int N = m_ref->m_abox.size();
+    if (m_ref->isCompressed()) {
+        m_ref->m_lattice.shift(IntVect::TheDimensionVector(dir)*nzones);
+        return *this;
+    }
+
+    auto& abox = m_ref->boxes();
+    const int N = abox.size();
 #ifdef AMREX_USE_OMP
 #pragma omp parallel for
 #endif
     for (int i = 0; i < N; i++) {
-        m_ref->m_abox[i].shift(dir, nzones);
+        abox[i].shift(dir, nzones);
     }
     return *this;
 }
@@ -837,12 +1207,18 @@ BoxArray::shift (const IntVect& iv)
 {
     uniqify();
 
-    const int N = m_ref->m_abox.size();
+    if (m_ref->isCompressed()) {
+        m_ref->m_lattice.shift(iv);
+        return *this;
+    }
+
+    auto& abox = m_ref->boxes();
+    const int N = abox.size();
 #ifdef AMREX_USE_OMP
 #pragma omp parallel for
 #endif
     for (int i = 0; i < N; i++) {
-        m_ref->m_abox[i].shift(iv);
+        abox[i].shift(iv);
     }
     return *this;
 }
@@ -854,7 +1230,7 @@ BoxArray::set (int i, const Box& ibox)
     if (i == 0) {
         m_bat.set_index_type(ibox.ixType());
     }
-    m_ref->m_abox[i] = amrex::enclosedCells(ibox);
+    m_ref->boxes()[i] = amrex::enclosedCells(ibox);
 }
 
 Box
@@ -869,7 +1245,7 @@ BoxArray::ok () const
     const int N = size();
     if (N > 0)
     {
-        auto const& bxs = this->m_ref->m_abox;
+        auto const& bxs = *m_ref;
         if (m_bat.is_null()) {
             for (int i = 0; i < N; ++i) {
                 if (! bxs[i].ok()) return false;
@@ -897,7 +1273,7 @@ BoxArray::isDisjoint () const
     std::vector< std::pair<int,Box> > isects;
 
     const int N = size();
-    auto const& bxs = this->m_ref->m_abox;
+    auto const& bxs = *m_ref;
     if (m_bat.is_null()) {
         for (int i = 0; i < N; ++i) {
             intersections(bxs[i],isects);
@@ -928,7 +1304,7 @@ BoxArray::boxList () const
     newb.data().reserve(N);
     if (N > 0) {
 	newb.set(ixType());
-        auto const& bxs = this->m_ref->m_abox;
+        auto const& bxs = *m_ref;
         if (m_bat.is_null()) {
             for (int i = 0; i < N; ++i) {
                 newb.push_back(bxs[i]);
@@ -1030,14 +1406,14 @@ BoxArray::minimalBox () const
 #endif
 	if (use_single_thread)
 	{
-	    minbox = m_ref->m_abox[0];
+	    minbox = (*m_ref)[0];
 	    for (int i = 1; i < N; ++i) {
-		minbox.minBox(m_ref->m_abox[i]);
+		minbox.minBox((*m_ref)[i]);
 	    }
 	}
 	else
 	{
-	    Vector<Box> bxs(nthreads, m_ref->m_abox[0]);
+	    Vector<Box> bxs(nthreads, (*m_ref)[0]);
 #ifdef AMREX_USE_OMP
 #pragma omp parallel
 #endif
@@ -1047,7 +1423,7 @@ BoxArray::minimalBox () const
 #pragma omp for
 #endif
 		for (int i = 0; i < N; ++i) {
-		    bxs[tid].minBox(m_ref->m_abox[i]);
+		    bxs[tid].minBox((*m_ref)[i]);
 		}
 	    }
 	    minbox = bxs[0];
@@ -1078,16 +1454,16 @@ BoxArray::minimalBox (Long& npts_avg_box) const
 #endif
         if (use_single_thread)
         {
-            minbox = m_ref->m_abox[0];
-            npts_tot += m_ref->m_abox[0].numPts();
+            minbox = (*m_ref)[0];
+            npts_tot += (*m_ref)[0].numPts();
             for (int i = 1; i < N; ++i) {
-                minbox.minBox(m_ref->m_abox[i]);
-                npts_tot += m_ref->m_abox[i].numPts();
+                minbox.minBox((*m_ref)[i]);
+                npts_tot += (*m_ref)[i].numPts();
             }
         }
         else
         {
-            Vector<Box> bxs(nthreads, m_ref->m_abox[0]);
+            Vector<Box> bxs(nthreads, (*m_ref)[0]);
 #ifdef AMREX_USE_OMP
 #pragma omp parallel reduction(+:npts_tot)
 #endif
@@ -1097,8 +1473,8 @@ BoxArray::minimalBox (Long& npts_avg_box) const
 #pragma omp for
 #endif
                 for (int i = 0; i < N; ++i) {
-                    bxs[tid].minBox(m_ref->m_abox[i]);
-                    Long npts = m_ref->m_abox[i].numPts();
+                    bxs[tid].minBox((*m_ref)[i]);
+                    Long npts = (*m_ref)[i].numPts();
                     npts_tot += npts;
                 }
             }
@@ -1180,11 +1556,11 @@ BoxArray::intersections (const Box&                         bx,
 {
   // This is called too many times BL_PROFILE("BoxArray::intersections()");
 
-    BARef::HashType& BoxHashMap = getHashMap();
+    getHashMap();
 
     isects.resize(0);
 
-    if (!BoxHashMap.empty())
+    if (!empty())
     {
         BL_ASSERT(bx.ixType() == ixType());
 
@@ -1196,66 +1572,51 @@ BoxArray::intersections (const Box&                         bx,
 	const IntVect& doihi = getDoiHi();
 
 	gbx.setSmall(glo - doihi).setBig(ghi + doilo);
-        gbx.refine(crseRatio()).coarsen(m_ref->crsn);
-	
-        const IntVect& sm = amrex::max(gbx.smallEnd()-1, m_ref->bbox.smallEnd());
-        const IntVect& bg = amrex::min(gbx.bigEnd(),     m_ref->bbox.bigEnd());
+        gbx.refine(crseRatio());
 
-        Box cbx(sm,bg);
-        cbx.normalize();
+        auto const& abox = *m_ref;
 
-	if (!cbx.intersects(m_ref->bbox)) return;
-
-	auto TheEnd = BoxHashMap.cend();
-
-        auto& abox = m_ref->m_abox;
+        if (m_bat.is_null()) {
+            for_each_candidate_box(*m_ref, gbx, crseRatio(), [&] (int index) -> bool
+            {
+                const Box& ibox = abox[index];
+                const Box& isect = bx & amrex::grow(ibox,ng);
 
-        for (IntVect iv = cbx.smallEnd(), End = cbx.bigEnd(); iv <= End; cbx.next(iv))
-        {
-            auto it = BoxHashMap.find(iv);
+                if (isect.ok())
+                {
+                    isects.push_back(std::pair<int,Box>(index,isect));
+                    if (first_only) return true;
+                }
+                return false;
+            });
+        } else if (m_bat.is_simple()) {
+            IndexType t = ixType();
+            IntVect cr = crseRatio();
+            for_each_candidate_box(*m_ref, gbx, crseRatio(), [&] (int index) -> bool
+            {
+                const Box& ibox = amrex::convert(amrex::coarsen(abox[index],cr),t);
+                const Box& isect = bx & amrex::grow(ibox,ng);
 
-            if (it != TheEnd)
+                if (isect.ok())
+                {
+                    isects.push_back(std::pair<int,Box>(index,isect));
+                    if (first_only) return true;
+                }
+                return false;
+            });
+        } else {
+            for_each_candidate_box(*m_ref, gbx, crseRatio(), [&] (int index) -> bool
             {
-                if (m_bat.is_null()) {
-                    for (const int index : it->second)
-                    {
-                        const Box& ibox = abox[index];
-                        const Box& isect = bx & amrex::grow(ibox,ng);
-
-                        if (isect.ok())
-                        {
-                            isects.push_back(std::pair<int,Box>(index,isect));
-                            if (first_only) return;
-                        }
-                    }
-                } else if (m_bat.is_simple()) {
-                    IndexType t = ixType();
-                    IntVect cr = crseRatio();
-                    for (const int index : it->second)
-                    {
-                        const Box& ibox = amrex::convert(amrex::coarsen(abox[index],cr),t);
-                        const Box& isect = bx & amrex::grow(ibox,ng);
-
-                        if (isect.ok())
-                        {
-                            isects.push_back(std::pair<int,Box>(index,isect));
-                            if (first_only) return;
-                        }
-                    }
-                } else {
-                    for (const int index : it->second)
-                    {
-                        const Box& ibox = m_bat.m_op.m_bndryReg(abox[index]);
-                        const Box& isect = bx & amrex::grow(ibox,ng);
-
-                        if (isect.ok())
-                        {
-                            isects.push_back(std::pair<int,Box>(index,isect));
-                            if (first_only) return;
-                        }
-                    }
+                const Box& ibox = m_bat.m_op.m_bndryReg(abox[index]);
+                const Box& isect = bx & amrex::grow(ibox,ng);
+
+                if (isect.ok())
+                {
+                    isects.push_back(std::pair<int,Box>(index,isect));
+                    if (first_only) return true;
                 }
-            }
+                return false;
+            });
         }
     }
 }
@@ -1277,7 +1638,7 @@ BoxArray::complementIn (BoxList& bl, const Box& bx) const
 
     if (empty()) return;
 
-    BARef::HashType& BoxHashMap = getHashMap();
+    getHashMap();
 
     BL_ASSERT(bx.ixType() == ixType());
 
@@ -1289,60 +1650,38 @@ BoxArray::complementIn (BoxList& bl, const Box& bx) const
     const IntVect& doihi = getDoiHi();
 
     gbx.setSmall(glo - doihi).setBig(ghi + doilo);
-    gbx.refine(crseRatio()).coarsen(m_ref->crsn);
-
-    const IntVect& sm = amrex::max(gbx.smallEnd()-1, m_ref->bbox.smallEnd());
-    const IntVect& bg = amrex::min(gbx.bigEnd(),     m_ref->bbox.bigEnd());
-
-    Box cbx(sm,bg);
-    cbx.normalize();
-
-    if (!cbx.intersects(m_ref->bbox)) return;
-
-    auto TheEnd = BoxHashMap.cend();
+    gbx.refine(crseRatio());
 
     Vector<Box> intersect_boxes;
-    auto& abox = m_ref->m_abox;
+    auto const& abox = *m_ref;
     if (m_bat.is_null()) {
-        AMREX_LOOP_3D(cbx, i, j, k,
+        for_each_candidate_box(*m_ref, gbx, crseRatio(), [&] (int index) -> bool
         {
-            auto it = BoxHashMap.find(IntVect(AMREX_D_DECL(i,j,k)));
-            if (it != TheEnd) {
-                for (const int index : it->second) {
-                    const Box& ibox = abox[index];
-                    if (bx.intersects(ibox)) {
-                        intersect_boxes.push_back(ibox);
-                    }
-                }
+            const Box& ibox = abox[index];
+            if (bx.intersects(ibox)) {
+                intersect_boxes.push_back(ibox);
             }
+            return false;
         });
     } else if (m_bat.is_simple()) {
         IndexType t = ixType();
         IntVect cr = crseRatio();
-        AMREX_LOOP_3D(cbx, i, j, k,
+        for_each_candidate_box(*m_ref, gbx, crseRatio(), [&] (int index) -> bool
         {
-            auto it = BoxHashMap.find(IntVect(AMREX_D_DECL(i,j,k)));
-            if (it != TheEnd) {
-                for (const int index : it->second) {
-                    const Box& ibox = amrex::convert(amrex::coarsen(abox[index],cr),t);
-                    if (bx.intersects(ibox)) {
-                        intersect_boxes.push_back(ibox);
-                    }
-                }
+            const Box& ibox = amrex::convert(amrex::coarsen(abox[index],cr),t);
+            if (bx.intersects(ibox)) {
+                intersect_boxes.push_back(ibox);
             }
+            return false;
         });
     } else {
-        AMREX_LOOP_3D(cbx, i, j, k,
+        for_each_candidate_box(*m_ref, gbx, crseRatio(), [&] (int index) -> bool
         {
-            auto it = BoxHashMap.find(IntVect(AMREX_D_DECL(i,j,k)));
-            if (it != TheEnd) {
-                for (const int index : it->second) {
-                    const Box& ibox = m_bat.m_op.m_bndryReg(abox[index]);
-                    if (bx.intersects(ibox)) {
-                        intersect_boxes.push_back(ibox);
-                    }
-                }
+            const Box& ibox = m_bat.m_op.m_bndryReg(abox[index]);
+            if (bx.intersects(ibox)) {
+                intersect_boxes.push_back(ibox);
             }
+            return false;
         });
     }
 
@@ -1372,6 +1711,16 @@ BoxArray::clear_hash_bin () const
     }
 }
 
+Long
+BoxArray::bytes () const
+{
+    Long b = sizeof(BARef) + m_ref->boxBytes();
+    if (m_ref->HasHashMap()) {
+        b += m_ref->hashBytes();
+    }
+    return b;
+}
+
 //
 // Currently this assumes your Boxes are cell-centered.
 //
@@ -1387,8 +1736,9 @@ BoxArray::removeOverlap (bool simplify)
     }
 
     uniqify();
+    m_ref->boxes(); // the boxes and the hash bins are modified in place below
 
-    BARef::HashType& BoxHashMap = m_ref->hash;
+    auto& bins = m_ref->hash;
 
     const Box EmptyBox;
 
@@ -1423,7 +1773,7 @@ BoxArray::removeOverlap (bool simplify)
                 for (const Box& b : bl_diff)
                 {
                     m_ref->m_abox.push_back(b);
-                    BoxHashMap[amrex::coarsen(b.smallEnd(),m_ref->crsn)].push_back(size()-1);
+                    add_to_hash_bins(bins, b, size()-1);
                 }
             }
         }
@@ -1463,10 +1813,11 @@ BoxArray::type_update ()
     {
 	if (! ixType().cellCentered())
 	{
-            for (auto& bx : m_ref->m_abox) {
+            for (auto& bx : m_ref->boxes()) {
 		bx.enclosedCells();
 	    }
 	}
+        m_ref->compress();
     }
 }
 
@@ -1482,58 +1833,37 @@ BoxArray::getDoiHi () const noexcept
     return m_bat.doiHi();
 }
 
-BARef::HashType&
+Vector<BARef::HashBin>&
 BoxArray::getHashMap () const
 {
-    BARef::HashType& BoxHashMap = m_ref->hash;
+    auto& bins = m_ref->hash;
 
-    if (m_ref->HasHashMap()) return BoxHashMap;
+    // A lattice is searched directly.
+    if (m_ref->HasHashMap() || m_ref->isCompressed()) return bins;
 
-#ifdef AMREX_USE_OMP
-#pragma omp critical(intersections_lock)
-#endif
-    {
-        if (BoxHashMap.empty() && size() > 0)
-        {
-            //
-            // Calculate the bounding box & maximum extent of the boxes.
-            //
-	    IntVect maxext = IntVect::TheUnitVector();
-            Box boundingbox = m_ref->m_abox[0];
-
-	    const int N = size();
-	    for (int i = 0; i < N; ++i)
-            {
-                Box bx = m_ref->m_abox[i];
-                bx.normalize();
-                maxext = amrex::max(maxext, bx.size());
-                boundingbox.minBox(bx);
-            }
-
-            for (int i = 0; i < N; i++)
-            {
-                const IntVect& crsnsmlend 
-		    = amrex::coarsen(m_ref->m_abox[i].smallEnd(),maxext);
-                BoxHashMap[crsnsmlend].push_back(i);
-            }
+    // The lock is per BARef so that building the hash of a big BoxArray
+    // does not hold up threads working with other BoxArrays.
+    std::lock_guard<std::mutex> lock(m_ref->hash_mutex);
 
-            m_ref->crsn = maxext;
-            m_ref->bbox = boundingbox.coarsen(maxext);
-            m_ref->bbox.normalize();
+    if (bins.empty() && size() > 0)
+    {
+        bins = make_hash_bins(m_ref->m_abox);
 
 #ifdef AMREX_MEM_PROFILING
-	    m_ref->updateMemoryUsage_hash(1);
+#ifdef AMREX_USE_OMP
+#pragma omp critical(intersections_lock)
+#endif
+        m_ref->updateMemoryUsage_hash(1);
 #endif
 
 #ifdef AMREX_USE_OMP
 #pragma omp flush
 #pragma omp atomic write
 #endif
-            m_ref->has_hashmap = true;
-        }
+        m_ref->has_hashmap = true;
     }
 
-    return BoxHashMap;
+    return bins;
 }
 
 void
@@ -1547,12 +1877,15 @@ BoxArray::uniqify ()
     }
     IntVect cr = crseRatio();
     if (cr != IntVect::TheUnitVector()) {
-        const int N = m_ref->m_abox.size();
+        if (!m_ref->isCompressed() || !m_ref->m_lattice.coarsen(cr)) {
+            auto& abox = m_ref->boxes();
+            const int N = abox.size();
 #ifdef AMREX_USE_OMP
 #pragma omp parallel for
 #endif
-        for (int i = 0; i < N; i++) {
-            m_ref->m_abox[i].coarsen(cr);
+            for (int i = 0; i < N; i++) {
+                abox[i].coarsen(cr);
+            }
         }
         m_bat.set_coarsen_ratio(IntVect::TheUnitVector());
     }
@@ -1576,6 +1909,73 @@ BoxArray::simplified () const
     return BoxArray(simplified_list()).convert(ixType());
 }
 
+LocalBoxArrayView::LocalBoxArrayView (const BoxArray& ba, const Vector<int>& index,
+                                      const IntVect& ngrow, const std::vector<IntVect>& shifts)
+{
+    // A lattice is searched without a hash, so it is used as it is.
+    if (ba.isCompressed()) {
+        m_ba = ba;
+        return;
+    }
+
+    BoxList region(ba.ixType());
+    region.reserve(index.size()*shifts.size());
+    for (const int i : index) {
+        const Box& gbx = amrex::grow(ba[i], ngrow);
+        for (const auto& iv : shifts) {
+            region.push_back(gbx+iv);
+        }
+    }
+
+    if (ba.m_ref->HasHashMap())
+    {
+        std::vector< std::pair<int,Box> > isects;
+        for (const Box& b : region) {
+            ba.intersections(b, isects);
+            for (const auto& is : isects) {
+                m_index.push_back(is.first);
+            }
+        }
+        std::sort(m_index.begin(), m_index.end());
+        m_index.erase(std::unique(m_index.begin(), m_index.end()), m_index.end());
+    }
+    else
+    {
+        // Do not build the hash of the full BoxArray.
+        const BoxArray rba(std::move(region));
+        for (int j = 0, N = ba.size(); j < N; ++j) {
+            if (rba.intersects(ba[j])) {
+                m_index.push_back(j);
+            }
+        }
+    }
+
+    BoxList bl(ba.ixType());
+    bl.reserve(m_index.size());
+    for (const int j : m_index) {
+        bl.push_back(ba[j]);
+    }
+    m_ba = BoxArray(std::move(bl));
+}
+
+void
+LocalBoxArrayView::intersections (const Box& bx, std::vector< std::pair<int,Box> >& isects,
+                                  bool first_only, const IntVect& ng) const
+{
+    m_ba.intersections(bx, isects, first_only, ng);
+    if (!m_index.empty()) {
+        for (auto& is : isects) {
+            is.first = m_index[is.first];
+        }
+    }
+}
+
+Long
+LocalBoxArrayView::bytes () const
+{
+    return sizeof(*this) + m_ba.bytes() + amrex::bytesOf(m_index);
+}
+
 std::ostream&
 operator<< (std::ostream&   os,
             const BoxArray& ba)
@@ -1666,16 +2066,73 @@ intersect (const BoxArray& ba,
     return r;
 }
 
+namespace {
+
+//
+// Appends the intersections of ba with get_box(0), ..., get_box(nboxes-1)
+// to bl, in that order.  The boxes are split into contiguous blocks, one per
+// thread, and the per-thread results are concatenated in thread order, so
+// the result does not depend on the number of threads.
+//
+template <class F>
+void
+intersect_boxes (const BoxArray& ba, int nboxes, F const& get_box, BoxList& bl)
+{
+    if (ba.empty() || nboxes <= 0) return;
+
+    const int nthreads = (OpenMP::in_parallel() || nboxes < 64)
+        ? 1 : OpenMP::get_max_threads();
+
+    if (nthreads == 1)
+    {
+        std::vector< std::pair<int,Box> > isects;
+        for (int i = 0; i < nboxes; ++i)
+        {
+            ba.intersections(get_box(i), isects);
+            for (auto const& is : isects) {
+                bl.push_back(is.second);
+            }
+        }
+    }
+    else
+    {
+        Vector<Vector<Box> > tbl(nthreads);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel num_threads(nthreads)
+#endif
+        {
+            auto& bv = tbl[OpenMP::get_thread_num()];
+            std::vector< std::pair<int,Box> > isects;
+#ifdef AMREX_USE_OMP
+#pragma omp for schedule(static)
+#endif
+            for (int i = 0; i < nboxes; ++i)
+            {
+                ba.intersections(get_box(i), isects);
+                for (auto const& is : isects) {
+                    bv.push_back(is.second);
+                }
+            }
+        }
+        std::size_t ntot = bl.size();
+        for (auto const& bv : tbl) {
+            ntot += bv.size();
+        }
+        bl.reserve(ntot);
+        for (auto const& bv : tbl) {
+            bl.data().insert(bl.data().end(), bv.begin(), bv.end());
+        }
+    }
+}
+
+}
+
 BoxArray
 intersect (const BoxArray& lhs, const BoxArray& rhs)
 {
     if (lhs.size() == 0 || rhs.size() == 0) return BoxArray();
     BoxList bl(lhs[0].ixType());
-    for (int i = 0, Nl = lhs.size(); i < Nl; ++i)
-    {
-        const BoxArray& ba = amrex::intersect(rhs, lhs[i]);
-        bl.join(ba.boxList());
-    }
+    intersect_boxes(rhs, lhs.size(), [&lhs] (int i) { return lhs[i]; }, bl);
     return BoxArray(bl);
 }
 
@@ -1683,11 +2140,8 @@ BoxList
 intersect (const BoxArray& ba, const BoxList& bl)
 {
     BoxList newbl(bl.ixType());
-    for (const Box& bx : bl)
-    {
-        const BoxArray& newba = amrex::intersect(ba, bx);
-        newbl.join(newba.boxList());
-    }
+    Box const* bxs = bl.data().data();
+    intersect_boxes(ba, bl.size(), [bxs] (int i) { return bxs[i]; }, newbl);
     return newbl;
 }
 
@@ -658,17 +658,101 @@ boxDiff (BoxList& bl_diff, const Box& b1in, const Box& b2)
 int
 BoxList::simplify (bool best)
 {
+    if (best) return simplify_sweep();
+
     std::sort(m_lbox.begin(), m_lbox.end(), [](const Box& l, const Box& r) {
             return l.smallEnd() < r.smallEnd(); });
 
     //
-    // If we're not looking for the "best" we can do in one pass, we
-    // limit how far afield we look for abutting boxes.  This greatly
+    // We limit how far afield we look for abutting boxes.  This greatly
     // speeds up this routine for large numbers of boxes.  It does not
-    // do quite as good a job though as full brute force.
+    // do quite as good a job though as simplify_sweep.
+    //
+    return simplify_doit(100);
+}
+
+int
+BoxList::simplify_sweep ()
+{
+    //
+    // Two boxes can be merged if they have the same extents in all
+    // directions but one and touch or overlap in that one.  For each
+    // direction, sorting by the extents in the other directions and then by
+    // the lower end puts such boxes next to each other, so that they can be
+    // merged in a single sweep.  Merging in one direction can make new
+    // merges possible in another, so we repeat until nothing changes.
     //
-    int depth = best ? size() : 100;
-    return simplify_doit(depth);
+    int count = 0;
+    Vector<int> bucket;
+    bool merged = true;
+    while (merged)
+    {
+        merged = false;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+        {
+            const int N = size();
+            if (N < 2) return count;
+
+            auto same_section = [idim] (const Box& a, const Box& b) -> bool {
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    if (d != idim && (a.smallEnd(d) != b.smallEnd(d) ||
+                                      a.bigEnd(d)   != b.bigEnd(d))) {
+                        return false;
+                    }
+                }
+                return true;
+            };
+
+            std::sort(m_lbox.begin(), m_lbox.end(),
+                      [idim] (const Box& a, const Box& b) -> bool {
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    if (d != idim) {
+                        if (a.smallEnd(d) != b.smallEnd(d)) return a.smallEnd(d) < b.smallEnd(d);
+                        if (a.bigEnd(d)   != b.bigEnd(d)  ) return a.bigEnd(d)   < b.bigEnd(d);
+                    }
+                }
+                return a.smallEnd(idim) < b.smallEnd(idim);
+            });
+
+            bucket.clear();
+            bucket.push_back(0);
+            for (int i = 1; i < N; ++i) {
+                if (!same_section(m_lbox[i-1], m_lbox[i])) bucket.push_back(i);
+            }
+            bucket.push_back(N);
+
+            const int nbuckets = bucket.size()-1;
+            if (nbuckets == N) continue;
+
+            int nmerged = 0;
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for reduction(+:nmerged) if (nbuckets > 1024 && !omp_in_parallel())
+#endif
+            for (int ib = 0; ib < nbuckets; ++ib)
+            {
+                int cur = bucket[ib];
+                for (int i = bucket[ib]+1; i < bucket[ib+1]; ++i)
+                {
+                    Box& a = m_lbox[cur];
+                    Box& b = m_lbox[i];
+                    if (b.smallEnd(idim) <= a.bigEnd(idim)+1) {
+                        a.setBig(idim, std::max(a.bigEnd(idim), b.bigEnd(idim)));
+                        b = Box();
+                        ++nmerged;
+                    } else {
+                        cur = i;
+                    }
+                }
+            }
+
+            if (nmerged > 0) {
+                removeEmpty();
+                count += nmerged;
+                merged = true;
+            }
+        }
+    }
+    return count;
 }
 
 int
@@ -14,6 +14,7 @@
 #include <sstream>
 #include <cstdlib>
 #include <map>
+#include <mutex>
 #include <vector>
 #include <queue>
 #include <algorithm>
@@ -36,6 +37,7 @@ namespace amrex {
     int    sfc_threshold;
     Real   max_efficiency;
     int    node_size;
+    Long   compress_min_size;
 
 // We default to SFC.
 DistributionMapping::Strategy DistributionMapping::m_Strategy = DistributionMapping::SFC;
@@ -45,9 +47,85 @@ DistributionMapping::PVMF DistributionMapping::m_BuildMap = 0;
 const Vector<int>&
 DistributionMapping::ProcessorMap () const noexcept
 {
+    if (m_ref->isCompressed())
+    {
+        bool has_pmap;
+#ifdef AMREX_USE_OMP
+#pragma omp atomic read
+#endif
+        has_pmap = m_ref->m_has_pmap;
+
+        if (!has_pmap)
+        {
+            static std::mutex pmap_mutex;
+            std::lock_guard<std::mutex> lock(pmap_mutex);
+            if (!m_ref->m_has_pmap)
+            {
+                m_ref->m_pmap = ProcessorMapCopy();
+#ifdef AMREX_USE_OMP
+#pragma omp flush
+#pragma omp atomic write
+#endif
+                m_ref->m_has_pmap = true;
+            }
+        }
+    }
     return m_ref->m_pmap;
 }
 
+Vector<int>
+DistributionMapping::ProcessorMapCopy () const
+{
+    if (m_ref->isCompressed())
+    {
+        Vector<int> pmap(m_ref->size());
+        for (int r = 0, nruns = m_ref->m_run_rank.size(); r < nruns; ++r) {
+            std::fill(pmap.begin()+m_ref->m_run_start[r],
+                      pmap.begin()+m_ref->m_run_start[r+1], m_ref->m_run_rank[r]);
+        }
+        return pmap;
+    }
+    else
+    {
+        return m_ref->m_pmap;
+    }
+}
+
+void
+DistributionMapping::Ref::compress ()
+{
+    const int N = m_pmap.size();
+    if (N < compress_min_size) return;
+
+    int nruns = 0;
+    for (int i = 0; i < N; ++i) {
+        if (i == 0 || m_pmap[i] != m_pmap[i-1]) { ++nruns; }
+    }
+
+    // A run takes two ints and a box one.
+    if (N == 0 || 2*nruns+1 >= N) return;
+
+    m_run_start.reserve(nruns+1);
+    m_run_rank.reserve(nruns);
+    for (int i = 0; i < N; ++i) {
+        if (i == 0 || m_pmap[i] != m_pmap[i-1]) {
+            m_run_start.push_back(i);
+            m_run_rank.push_back(m_pmap[i]);
+        }
+    }
+    m_run_start.push_back(N);
+    Vector<int>().swap(m_pmap);
+    m_has_pmap = false;
+}
+
+Long
+DistributionMapping::bytes () const
+{
+    return sizeof(Ref) + amrex::bytesOf(m_ref->m_pmap) + amrex::bytesOf(m_ref->m_run_start)
+        + amrex::bytesOf(m_ref->m_run_rank) + amrex::bytesOf(m_ref->m_index_array)
+        + m_ref->m_ownership.capacity()/8;
+}
+
 DistributionMapping::Strategy
 DistributionMapping::strategy ()
 {
@@ -93,7 +171,21 @@ DistributionMapping::SFC_Threshold ()
 bool
 DistributionMapping::operator== (const DistributionMapping& rhs) const noexcept
 {
-    return m_ref == rhs.m_ref || m_ref->m_pmap == rhs.m_ref->m_pmap;
+    if (m_ref == rhs.m_ref) {
+        return true;
+    } else if (isCompressed() && rhs.isCompressed()) {
+        return m_ref->m_run_start == rhs.m_ref->m_run_start
+            && m_ref->m_run_rank  == rhs.m_ref->m_run_rank;
+    } else if (!isCompressed() && !rhs.isCompressed()) {
+        return m_ref->m_pmap == rhs.m_ref->m_pmap;
+    } else {
+        const Long N = size();
+        if (N != rhs.size()) return false;
+        for (int i = 0; i < N; ++i) {
+            if ((*this)[i] != rhs[i]) return false;
+        }
+        return true;
+    }
 }
 
 bool
@@ -113,6 +205,7 @@ DistributionMapping::Initialize ()
     sfc_threshold    = 0;
     max_efficiency   = 0.9_rt;
     node_size        = 0;
+    compress_min_size = 100000;
     flag_verbose_mapper = 0;
 
     ParmParse pp("DistributionMapping");
@@ -122,6 +215,7 @@ DistributionMapping::Initialize ()
     pp.query("efficiency",          max_efficiency);
     pp.query("sfc_threshold",       sfc_threshold);
     pp.query("node_size",           node_size);
+    pp.query("compress_min_size",   compress_min_size);
     pp.query("verbose_mapper",      flag_verbose_mapper);
 
     std::string theStrategy;
@@ -308,12 +402,14 @@ DistributionMapping::DistributionMapping (const Vector<int>& pmap)
     :
     m_ref(std::make_shared<Ref>(pmap))
 {
+    m_ref->compress();
 }
 
 DistributionMapping::DistributionMapping (Vector<int>&& pmap) noexcept
     :
     m_ref(std::make_shared<Ref>(std::move(pmap)))
 {
+    m_ref->compress();
 }
 
 DistributionMapping::DistributionMapping (const BoxArray& boxes,
@@ -329,8 +425,8 @@ DistributionMapping::DistributionMapping (const DistributionMapping& d1,
     :
     m_ref(std::make_shared<Ref>())
 {
-    m_ref->m_pmap = d1.ProcessorMap();
-    const auto& p2 = d2.ProcessorMap();
+    m_ref->m_pmap = d1.ProcessorMapCopy();
+    const auto p2 = d2.ProcessorMapCopy();
     m_ref->m_pmap.insert(m_ref->m_pmap.end(), p2.begin(), p2.end());
 }
 
@@ -344,6 +440,8 @@ DistributionMapping::define (const BoxArray& boxes,
     BL_ASSERT(m_BuildMap != 0);
 
     (this->*m_BuildMap)(boxes,nprocs);
+
+    m_ref->compress();
 }
 
 void
@@ -351,6 +449,7 @@ DistributionMapping::define (const Vector<int>& pmap)
 {
     m_ref->clear();
     m_ref->m_pmap = pmap;
+    m_ref->compress();
 }
 
 void
@@ -358,6 +457,7 @@ DistributionMapping::define (Vector<int>&& pmap) noexcept
 {
     m_ref->clear();
     m_ref->m_pmap = std::move(pmap);
+    m_ref->compress();
 }
 
 void
@@ -874,6 +974,7 @@ DistributionMapping::KnapSackProcessorMap (const BoxArray& boxes,
 {
     BL_ASSERT(boxes.size() > 0);
 
+    m_ref->clear();
     m_ref->m_pmap.resize(boxes.size());
 
     if (boxes.size() <= nprocs || nprocs < 2)
@@ -1547,7 +1648,7 @@ DistributionMapping::makeKnapSack (const LayoutData<Real>& rcost_local,
         Vector<int> pmap(rcost_local.DistributionMap().size());
         if (ParallelDescriptor::MyProc() == root)
         {
-            pmap = r.ProcessorMap();
+            pmap = r.ProcessorMapCopy();
         }
         
         // Broadcast vector from which to construct new distribution mapping
@@ -1791,7 +1892,7 @@ DistributionMapping::makeSFC (const LayoutData<Real>& rcost_local,
         Vector<int> pmap(rcost_local.DistributionMap().size());
         if (ParallelDescriptor::MyProc() == root)
         {
-            pmap = r.ProcessorMap();
+            pmap = r.ProcessorMapCopy();
         }
 
         // Broadcast vector from which to construct new distribution mapping
@@ -1849,8 +1950,8 @@ DistributionMapping::getIndexArray ()
     {
         int myProc = ParallelDescriptor::MyProc();
 
-        for(int i = 0, N = m_ref->m_pmap.size(); i < N; ++i) {
-            int rank = m_ref->m_pmap[i];
+        for(int i = 0, N = size(); i < N; ++i) {
+            int rank = (*this)[i];
             if (ParallelDescriptor::sameTeam(rank)) {
                 // If Team is not used (i.e., team size == 1), distributionMap[i] == myProc
                 m_ref->m_index_array.push_back(i);
@@ -1868,8 +1969,8 @@ DistributionMapping::getOwnerShip ()
     {
         int myProc = ParallelDescriptor::MyProc();
 
-        for(int i = 0, N = m_ref->m_pmap.size(); i < N; ++i) {
-            int rank = m_ref->m_pmap[i];
+        for(int i = 0, N = size(); i < N; ++i) {
+            int rank = (*this)[i];
             if (ParallelDescriptor::sameTeam(rank)) {
                 // If Team is not used (i.e., team size == 1), distributionMap[i] == myProc
                 m_ref->m_index_array.push_back(i);
@@ -1886,9 +1987,9 @@ operator<< (std::ostream&              os,
 {
     os << "(DistributionMapping" << '\n';
 
-    for (int i = 0; i < pmap.ProcessorMap().size(); ++i)
+    for (int i = 0; i < pmap.size(); ++i)
     {
-        os << "m_pmap[" << i << "] = " << pmap.ProcessorMap()[i] << '\n';
+        os << "m_pmap[" << i << "] = " << pmap[i] << '\n';
     }
 
     os << ')' << '\n';
@@ -1923,6 +2024,7 @@ DistributionMapping::readFrom (std::istream& is)
     if (is.fail()) {
         amrex::Error("DistributionMapping::readFrom(istream&) failed");
     }
+    m_ref->compress();
     return is;
 }
 
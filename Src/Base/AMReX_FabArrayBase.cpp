@@ -1,5 +1,6 @@
 
 #include <algorithm>
+#include <atomic>
 #include <AMReX_FabArrayBase.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Utility.H>
@@ -82,8 +83,13 @@ namespace
 {
     Arena* the_fa_arena = nullptr;
     bool initialized = false;
+    std::atomic<Long> comm_meta_data_next_id{0L};
 }
 
+FabArrayBase::CommMetaData::CommMetaData ()
+    : m_id(comm_meta_data_next_id++)
+{}
+
 void
 FabArrayBase::Initialize ()
 {
@@ -209,7 +215,7 @@ FabArrayBase::define (const BoxArray&            bxs,
     
     boxarray = bxs;
     
-    BL_ASSERT(dm.ProcessorMap().size() == bxs.size());
+    BL_ASSERT(dm.size() == bxs.size());
     distributionMap = dm;
 
     indexArray = distributionMap.getIndexArray();
@@ -672,6 +678,9 @@ FabArrayBase::FB::define_fb (const FabArrayBase& fa)
     std::vector< std::pair<int,Box> > isects;
     
     const std::vector<IntVect>& pshifts = m_period.shiftIntVect();
+
+    // All the searches below are within ng of the local boxes.
+    const LocalBoxArrayView nba(ba, imap, ng, pshifts);
     
     auto& send_tags = *m_SndTags;
     
@@ -683,7 +692,7 @@ FabArrayBase::FB::define_fb (const FabArrayBase& fa)
 
         for (auto pit=pshifts.cbegin(); pit!=pshifts.cend(); ++pit)
         {
-            ba.intersections(vbx+(*pit), isects, false, ng);
+            nba.intersections(vbx+(*pit), isects, false, ng);
 
             for (int j = 0, M = isects.size(); j < M; ++j)
             {
@@ -701,7 +710,7 @@ FabArrayBase::FB::define_fb (const FabArrayBase& fa)
                         // with boxes for overlapping ghost nodes.
                         const Box& ba_krcv   = amrex::grow(ba[krcv],1);
                         const Box& dst_bx_ng = (amrex::grow(ba_krcv,ng_ng) & (vbx_ng + (*pit)));
-                        const BoxList &bltmp = ba.complementIn(dst_bx_ng);
+                        const BoxList &bltmp = nba.complementIn(dst_bx_ng);
                         for (auto const& btmp : bltmp)
                         {
                             bl.join(amrex::boxDiff(btmp,ba_krcv));
@@ -755,7 +764,7 @@ FabArrayBase::FB::define_fb (const FabArrayBase& fa)
 
         for (auto pit=pshifts.cbegin(); pit!=pshifts.cend(); ++pit)
         {
-            ba.intersections(bxrcv+(*pit), isects);
+            nba.intersections(bxrcv+(*pit), isects);
 
             for (int j = 0, M = isects.size(); j < M; ++j)
             {
@@ -772,7 +781,7 @@ FabArrayBase::FB::define_fb (const FabArrayBase& fa)
                     Box ba_ksnd = ba[ksnd];
                     ba_ksnd.grow(1);
                     const Box dst_bx_ng = (ba_ksnd & (bxrcv + (*pit))) - (*pit);
-                    const BoxList &bltmp = ba.complementIn(dst_bx_ng);
+                    const BoxList &bltmp = nba.complementIn(dst_bx_ng);
                     for (auto const& btmp : bltmp)
                     {
                         bl.join(amrex::boxDiff(btmp,vbx_ng));
@@ -296,7 +296,7 @@ ForkJoin::get_dm (const BoxArray& ba, int task_idx, const DistributionMapping& d
         int rank_lo = split_bounds[task_idx];  // note that these ranks are not necessarily global
         int nprocs_task = NProcsTask(task_idx);
 
-        Vector<int> pmap = dm_orig.ProcessorMap(); // DistributionMapping stores global ranks
+        Vector<int> pmap = dm_orig.ProcessorMapCopy(); // DistributionMapping stores global ranks
         for (auto& r : pmap) {
             int lr = ParallelContext::global_to_local_rank(r);
             lr = lr%nprocs_task + rank_lo;
@@ -594,4 +594,132 @@ MFGhostIter::Initialize ()
     tile_array      = &(lta.tileArray);
 }
 
+MFOverlapIter::MFOverlapIter (const FabArrayBase& fabarray, const IntVect& ng,
+                              const MFItInfo& info,
+                              std::function<void()> test, std::function<void()> finish)
+    :
+    MFIter(fabarray, (unsigned char)(SkipInit|Tiling)),
+    m_test(std::move(test)),
+    m_finish(std::move(finish))
+{
+    tile_size = info.do_tiling ? info.tilesize : IntVect::TheZeroVector();
+    streams = info.num_streams;
+    device_sync = info.device_sync;
+    Initialize(ng);
+}
+
+void
+MFOverlapIter::Initialize (const IntVect& ng)
+{
+    const int tid = OpenMP::get_thread_num();
+    const int nthreads = OpenMP::get_num_threads();
+
+    const bool tiling = tile_size.allGT(IntVect::TheZeroVector());
+
+    // Interior tiles of all boxes first, then boundary tiles.
+    Vector<Box> tiles[2];
+    Vector<int> index[2];
+    Vector<int> localindex[2];
+
+    auto add_tiles = [&] (int which, const Box& bx, int K, int i)
+    {
+        if (tiling) {
+            BoxList tl(bx, tile_size);
+            for (const Box& t : tl) {
+                tiles[which].push_back(t);
+                index[which].push_back(K);
+                localindex[which].push_back(i);
+            }
+        } else {
+            tiles[which].push_back(bx);
+            index[which].push_back(K);
+            localindex[which].push_back(i);
+        }
+    };
+
+    for (int i = 0, N = fabArray.IndexArray().size(); i < N; ++i)
+    {
+        const int K = fabArray.IndexArray()[i];
+        const Box& vbx = fabArray.boxArray().getCellCenteredBox(K);
+        const Box& ibx = amrex::grow(vbx, -ng);
+        if (ibx.ok()) {
+            add_tiles(0, ibx, K, i);
+            for (const Box& b : amrex::boxDiff(vbx, ibx)) {
+                add_tiles(1, b, K, i);
+            }
+        } else {
+            add_tiles(1, vbx, K, i);
+        }
+    }
+
+    // Each thread takes its share of both kinds of tiles.
+    int nint = 0;
+    for (int which = 0; which < 2; ++which)
+    {
+        const int ntot = tiles[which].size();
+        const int nr   = ntot / nthreads;
+        const int nlft = ntot - nr * nthreads;
+        const int ib = tid * nr + std::min(tid, nlft);
+        const int ie = ib + nr + (tid < nlft ? 1 : 0);
+        for (int it = ib; it < ie; ++it) {
+            lta.tileArray.push_back(tiles[which][it]);
+            lta.indexMap.push_back(index[which][it]);
+            lta.localIndexMap.push_back(localindex[which][it]);
+        }
+        if (which == 0) nint = lta.tileArray.size();
+    }
+
+    lta.nuse = 0;
+    index_map       = &(lta.indexMap);
+    local_index_map = &(lta.localIndexMap);
+    tile_array      = &(lta.tileArray);
+    typ = fabArray.boxArray().ixType();
+
+    currentIndex = beginIndex = 0;
+    endIndex = nint;
+
+#ifdef AMREX_USE_GPU
+    Gpu::Device::setStreamIndex((streams > 0) ? currentIndex%streams : -1);
+    Gpu::resetNumCallbacks();
+#endif
+
+    if (endIndex == 0) startBoundary();
+}
+
+void
+MFOverlapIter::startBoundary ()
+{
+    m_boundary = true;
+
+#ifdef AMREX_USE_OMP
+#pragma omp barrier
+#pragma omp master
+#endif
+    {
+        m_finish();
+    }
+#ifdef AMREX_USE_OMP
+#pragma omp barrier
+#endif
+
+    endIndex = lta.indexMap.size();
+}
+
+void
+MFOverlapIter::operator++ ()
+{
+    MFIter::operator++();
+
+    if (!m_boundary)
+    {
+        if (currentIndex < endIndex) {
+            if (OpenMP::get_thread_num() == 0) {
+                m_test();
+            }
+        } else {
+            startBoundary();
+        }
+    }
+}
+
 }
@@ -908,7 +908,7 @@ void WriteMultiLevelPlotfileHDF5 (const std::string& plotfilename,
         }
 
         // Get the boxes assigned to all ranks and calculate their offsets and sizes
-        Vector<int> procMap = mf[level]->DistributionMap().ProcessorMap();
+        Vector<int> procMap = mf[level]->DistributionMap().ProcessorMapCopy();
         const BoxArray& grids = mf[level]->boxArray();
         hid_t boxdataset, boxdataspace;
         hid_t offsetdataset, offsetdataspace;
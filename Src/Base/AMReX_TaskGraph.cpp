@@ -0,0 +1,160 @@
+
+#include <AMReX_TaskGraph.H>
+#include <AMReX_BLassert.H>
+#include <AMReX_OpenMP.H>
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace amrex {
+
+TaskGraph::Task
+TaskGraph::add (std::function<void()> f, Vector<Task> const& deps)
+{
+    const Task t = m_nodes.size();
+    m_nodes.emplace_back();
+    m_nodes.back().work = std::move(f);
+    for (Task dep : deps) {
+        addDependency(t, dep);
+    }
+    return t;
+}
+
+TaskGraph::Task
+TaskGraph::addPoll (std::function<bool()> f, Vector<Task> const& deps)
+{
+    const Task t = m_nodes.size();
+    m_nodes.emplace_back();
+    m_nodes.back().poll = std::move(f);
+    for (Task dep : deps) {
+        addDependency(t, dep);
+    }
+    return t;
+}
+
+TaskGraph::Task
+TaskGraph::addMaster (std::function<void()> f, Vector<Task> const& deps)
+{
+    const Task t = add(std::move(f), deps);
+    m_nodes[t].master = true;
+    if (m_last_master >= 0) {
+        addDependency(t, m_last_master);
+    }
+    m_last_master = t;
+    return t;
+}
+
+void
+TaskGraph::addDependency (Task t, Task dep)
+{
+    AMREX_ASSERT(t >= 0 && t < size() && dep >= 0 && dep < size() && t != dep);
+    m_nodes[dep].successors.push_back(t);
+    ++m_nodes[t].ndeps;
+}
+
+void
+TaskGraph::run ()
+{
+    const int N = m_nodes.size();
+    if (N == 0) return;
+
+    std::mutex mtx;
+    std::deque<Task> ready;        // work tasks whose dependencies are done
+    std::deque<Task> master_ready; // the same for master tasks
+    Vector<Task> polling;          // poll tasks whose dependencies are done
+    Vector<int> ndeps(N);
+    int ndone = 0;
+    int nrunning = 0;
+
+    auto make_ready = [&] (Task t)
+    {
+        if (m_nodes[t].poll) {
+            polling.push_back(t);
+        } else if (m_nodes[t].master) {
+            master_ready.push_back(t);
+        } else {
+            ready.push_back(t);
+        }
+    };
+
+    for (Task t = 0; t < N; ++t) {
+        ndeps[t] = m_nodes[t].ndeps;
+        if (ndeps[t] == 0) make_ready(t);
+    }
+
+    // Must be called with the lock held.
+    auto complete = [&] (Task t)
+    {
+        ++ndone;
+        for (Task s : m_nodes[t].successors) {
+            if (--ndeps[s] == 0) make_ready(s);
+        }
+    };
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+    {
+        const bool master = OpenMP::get_thread_num() == 0;
+        Vector<Task> mypolls;
+
+        while (true)
+        {
+            Task t = -1;
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                if (ndone == N) break;
+                if (master && !master_ready.empty()) {
+                    t = master_ready.front();
+                    master_ready.pop_front();
+                    ++nrunning;
+                } else if (!ready.empty()) {
+                    t = ready.front();
+                    ready.pop_front();
+                    ++nrunning;
+                } else if (master) {
+                    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(nrunning > 0 || !polling.empty(),
+                                                     "TaskGraph::run: the graph has a cycle");
+                    mypolls.swap(polling);
+                }
+            }
+
+            if (t >= 0)
+            {
+                m_nodes[t].work();
+                std::lock_guard<std::mutex> lock(mtx);
+                --nrunning;
+                complete(t);
+            }
+
+            if (master)
+            {
+                if (t >= 0) {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    mypolls.swap(polling);
+                }
+                // Poll outside the lock.  The tasks that are not done go back.
+                auto it = std::partition(mypolls.begin(), mypolls.end(),
+                                         [&] (Task p) { return !m_nodes[p].poll(); });
+                const bool progress = (t >= 0) || (it != mypolls.end());
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    polling.insert(polling.end(), mypolls.begin(), it);
+                    for (auto p = it; p != mypolls.end(); ++p) {
+                        complete(*p);
+                    }
+                }
+                mypolls.clear();
+                if (!progress) std::this_thread::yield();
+            }
+            else if (t < 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+}
@@ -739,10 +739,10 @@ VisMF::Header::CalculateMinMax (const FabArray<FArrayBox>& mf,
     Vector<int> nmtags(ParallelDescriptor::NProcs(comm), 0);
     Vector<int> offset(ParallelDescriptor::NProcs(comm), 0);
 
-    const Vector<int> &pmap = mf.DistributionMap().ProcessorMap();
+    const DistributionMapping& dm = mf.DistributionMap();
 
     for(int i(0), N = mf.size(); i < N; ++i) {
-        ++nmtags[pmap[i]];
+        ++nmtags[dm[i]];
     }
 
     for(int i(0), N(nmtags.size()); i < N; ++i) {
@@ -798,20 +798,20 @@ VisMF::Header::CalculateMinMax (const FabArray<FArrayBox>& mf,
 
     if(ParallelDescriptor::MyProc(comm) == procToWrite) {
         for(int i(0), N(mf.size()); i < N; ++i) {
-            if(pmap[i] != procToWrite) {
+            if(dm[i] != procToWrite) {
                 m_min[i].resize(m_ncomp);
                 m_max[i].resize(m_ncomp);
             }
         }
 
         for(int j(0), N(mf.size()); j < N; ++j) {
-            if(pmap[j] != procToWrite) {
+            if(dm[j] != procToWrite) {
                 for(int k(0); k < m_ncomp; ++k) {
-                    m_min[j][k] = recvdata[offset[pmap[j]]+k];
-                    m_max[j][k] = recvdata[offset[pmap[j]]+k+m_ncomp];
+                    m_min[j][k] = recvdata[offset[dm[j]]+k];
+                    m_max[j][k] = recvdata[offset[dm[j]]+k+m_ncomp];
                 }
 
-                offset[pmap[j]] += 2*m_ncomp;
+                offset[dm[j]] += 2*m_ncomp;
             }
         }
     }
@@ -982,11 +982,11 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
 
     // ---- check if mf has sparse data
     bool useSparseFPP(false);
-    const Vector<int> &pmap = mf.DistributionMap().ProcessorMap();
+    const DistributionMapping& dm = mf.DistributionMap();
     std::set<int> procsWithData;
     Vector<int> procsWithDataVector;
-    for(int i(0); i < pmap.size(); ++i) {
-      procsWithData.insert(pmap[i]);
+    for(int i(0); i < dm.size(); ++i) {
+      procsWithData.insert(dm[i]);
     }
     if(allowSparseWrites && (procsWithData.size() < nOutFiles)) {
       useSparseFPP = true;
@@ -1179,10 +1179,10 @@ VisMF::FindOffsets (const FabArray<FArrayBox> &mf,
     Vector<int> nmtags(nProcs,0);
     Vector<int> offset(nProcs,0);
 
-    const Vector<int> &pmap = mf.DistributionMap().ProcessorMap();
+    const DistributionMapping& dm = mf.DistributionMap();
 
     for(int i(0), N(mf.size()); i < N; ++i) {
-        ++nmtags[pmap[i]];
+        ++nmtags[dm[i]];
     }
 
     for(int i(1), N(offset.size()); i < N; ++i) {
@@ -1226,7 +1226,7 @@ VisMF::FindOffsets (const FabArray<FArrayBox> &mf,
         Vector<int> cnt(nProcs,0);
 
         for(int j(0), N(mf.size()); j < N; ++j) {
-            const int i(pmap[j]);
+            const int i(dm[j]);
             hdr.m_fod[j].m_head = recvdata[offset[i]+cnt[i]];
 
             const std::string name(NFilesIter::FileName(nOutFiles, filePrefix, i, groupSets));
@@ -11,7 +11,13 @@
 #include <AMReX_EB2.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX.H>
+#include <AMReX_Utility.H>
 #include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
 
 namespace amrex { namespace EB2 {
 
@@ -19,12 +25,18 @@ Vector<std::unique_ptr<IndexSpace> > IndexSpace::m_instance;
 
 int max_grid_size = 64;
 bool extend_domain_face = true;
+std::string cache_dir;
+std::string cache_key;
+bool cut_cell_list = false;
 
 void Initialize ()
 {
     ParmParse pp("eb2");
     pp.query("max_grid_size", max_grid_size);
     pp.query("extend_domain_face", extend_domain_face);
+    pp.query("cache_dir", cache_dir);
+    pp.query("cache_key", cache_key);
+    pp.query("cut_cell_list", cut_cell_list);
 
     amrex::ExecOnFinalize(Finalize);
 }
@@ -39,6 +51,125 @@ bool ExtendDomainFace ()
     return extend_domain_face;
 }
 
+bool UseCutCellList ()
+{
+    return cut_cell_list;
+}
+
+const std::string& CacheDir ()
+{
+    return cache_dir;
+}
+
+const std::string& CacheKey ()
+{
+    return cache_key;
+}
+
+std::string
+CacheDescription (const std::string& key, const Geometry& geom,
+                  int required_coarsening_level, int max_coarsening_level,
+                  int ngrow, bool build_coarse_level_by_coarsening,
+                  bool a_extend_domain_face)
+{
+    Real small_volfrac = 1.e-14;
+    {
+        ParmParse pp("eb2");
+        pp.query("small_volfrac", small_volfrac);
+    }
+
+    std::ostringstream os;
+    os << std::setprecision(std::numeric_limits<Real>::max_digits10);
+    os << "key=" << key
+       << " dim=" << AMREX_SPACEDIM
+       << " real=" << sizeof(Real)
+       << " domain=" << geom.Domain()
+       << " problo=";
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        os << geom.ProbLo(idim) << ",";
+    }
+    os << " probhi=";
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        os << geom.ProbHi(idim) << ",";
+    }
+    os << " coord=" << geom.Coord()
+       << " periodic=";
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        os << geom.isPeriodic(idim);
+    }
+    os << " crse=" << required_coarsening_level << "," << max_coarsening_level
+       << " ngrow=" << ngrow
+       << " coarsening=" << build_coarse_level_by_coarsening
+       << " extend_domain_face=" << a_extend_domain_face
+       << " max_grid_size=" << max_grid_size
+       << " small_volfrac=" << small_volfrac;
+    return os.str();
+}
+
+std::string
+CachePath (const std::string& description)
+{
+    // 64-bit FNV-1a hash
+    std::uint64_t h = 14695981039346656037ULL;
+    for (char c : description) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ULL;
+    }
+    std::ostringstream os;
+    os << cache_dir << "/eb2_" << std::hex << std::setw(16) << std::setfill('0') << h;
+    return os.str();
+}
+
+int
+ReadCacheHeader (const std::string& path, const std::string& description, Vector<int>& ngrow)
+{
+    const std::string hdr_name = path + "/Header";
+
+    int exist = 0;
+    if (ParallelDescriptor::IOProcessor()) {
+        exist = amrex::FileExists(hdr_name);
+    }
+    ParallelDescriptor::Bcast(&exist, 1, ParallelDescriptor::IOProcessorNumber());
+    if (!exist) return -1;
+
+    Vector<char> file_chars;
+    ParallelDescriptor::ReadAndBcastFile(hdr_name, file_chars);
+    std::istringstream is(file_chars.dataPtr(), std::istringstream::in);
+
+    std::string file_description;
+    std::getline(is, file_description);
+    if (file_description != description) {
+        if (amrex::Verbose()) {
+            amrex::Print() << "EB2: ignoring index space cache " << path
+                           << " built for a different geometry\n";
+        }
+        return -1;
+    }
+
+    int nlevels = -1;
+    is >> nlevels;
+    ngrow.resize(std::max(nlevels,0));
+    for (auto& ng : ngrow) {
+        is >> ng;
+    }
+    return is.fail() ? -1 : nlevels;
+}
+
+void
+WriteCacheHeader (const std::string& path, const std::string& description, const Vector<int>& ngrow)
+{
+    if (ParallelDescriptor::IOProcessor()) {
+        const std::string hdr_name = path + "/Header";
+        std::ofstream ofs(hdr_name.c_str());
+        if (!ofs.good()) amrex::FileOpenFailed(hdr_name);
+        ofs << description << "\n" << ngrow.size() << "\n";
+        for (auto ng : ngrow) {
+            ofs << ng << "\n";
+        }
+    }
+    ParallelDescriptor::Barrier();
+}
+
 void
 IndexSpace::push (IndexSpace* ispace)
 {
@@ -70,6 +201,29 @@ const IndexSpace* TopIndexSpaceIfPresent() noexcept {
     return nullptr;
 }
 
+namespace {
+// Cache key for the geometries built from ParmParse parameters
+std::string parmparse_cache_key (const ParmParse& pp, const std::string& geom_type,
+                                 const Vector<std::string>& names)
+{
+    if (!CacheKey().empty()) return CacheKey();
+
+    std::string key = "geom_type=" + geom_type;
+    for (auto const& name : names) {
+        key += " " + name + "=";
+        if (pp.contains(name.c_str())) {
+            const int n = pp.countval(name.c_str());
+            for (int i = 0; i < n; ++i) {
+                std::string v;
+                pp.get(name.c_str(), v, i);
+                key += v + ",";
+            }
+        }
+    }
+    return key;
+}
+}
+
 void
 Build (const Geometry& geom, int required_coarsening_level,
        int max_coarsening_level, int ngrow, bool build_coarse_level_by_coarsening)
@@ -83,7 +237,8 @@ Build (const Geometry& geom, int required_coarsening_level,
         EB2::AllRegularIF rif;
         EB2::GeometryShop<EB2::AllRegularIF> gshop(rif);
         EB2::Build(gshop, geom, required_coarsening_level,
-                   max_coarsening_level, ngrow, build_coarse_level_by_coarsening);
+                   max_coarsening_level, ngrow, build_coarse_level_by_coarsening,
+                   ExtendDomainFace(), parmparse_cache_key(pp, "all_regular", {}));
     }
     else if (geom_type == "box")
     {
@@ -100,7 +255,10 @@ Build (const Geometry& geom, int required_coarsening_level,
 
         EB2::GeometryShop<EB2::BoxIF> gshop(bf);
         EB2::Build(gshop, geom, required_coarsening_level,
-                   max_coarsening_level, ngrow, build_coarse_level_by_coarsening);
+                   max_coarsening_level, ngrow, build_coarse_level_by_coarsening,
+                   ExtendDomainFace(),
+                   parmparse_cache_key(pp, "box",
+                                       {"box_lo", "box_hi", "box_has_fluid_inside"}));
     }
     else if (geom_type == "cylinder")
     {
@@ -125,7 +283,11 @@ Build (const Geometry& geom, int required_coarsening_level,
 
         EB2::GeometryShop<EB2::CylinderIF> gshop(cf);
         EB2::Build(gshop, geom, required_coarsening_level,
-                   max_coarsening_level, ngrow, build_coarse_level_by_coarsening);
+                   max_coarsening_level, ngrow, build_coarse_level_by_coarsening,
+                   ExtendDomainFace(),
+                   parmparse_cache_key(pp, "cylinder",
+                                       {"cylinder_center", "cylinder_radius", "cylinder_height",
+                                        "cylinder_direction", "cylinder_has_fluid_inside"}));
     }
     else if (geom_type == "plane")
     {
@@ -139,7 +301,10 @@ Build (const Geometry& geom, int required_coarsening_level,
 
         EB2::GeometryShop<EB2::PlaneIF> gshop(pf);
         EB2::Build(gshop, geom, required_coarsening_level,
-                   max_coarsening_level, ngrow, build_coarse_level_by_coarsening);
+                   max_coarsening_level, ngrow, build_coarse_level_by_coarsening,
+                   ExtendDomainFace(),
+                   parmparse_cache_key(pp, "plane",
+                                       {"plane_point", "plane_normal"}));
     }
     else if (geom_type == "sphere")
     {
@@ -156,7 +321,10 @@ Build (const Geometry& geom, int required_coarsening_level,
 
         EB2::GeometryShop<EB2::SphereIF> gshop(sf);
         EB2::Build(gshop, geom, required_coarsening_level,
-                   max_coarsening_level, ngrow, build_coarse_level_by_coarsening);
+                   max_coarsening_level, ngrow, build_coarse_level_by_coarsening,
+                   ExtendDomainFace(),
+                   parmparse_cache_key(pp, "sphere",
+                                       {"sphere_center", "sphere_radius", "sphere_has_fluid_inside"}));
     }
     else if (geom_type == "torus")
     {
@@ -175,7 +343,10 @@ Build (const Geometry& geom, int required_coarsening_level,
 
         EB2::GeometryShop<EB2::TorusIF> gshop(sf);
         EB2::Build(gshop, geom, required_coarsening_level,
-                   max_coarsening_level, ngrow, build_coarse_level_by_coarsening);
+                   max_coarsening_level, ngrow, build_coarse_level_by_coarsening,
+                   ExtendDomainFace(),
+                   parmparse_cache_key(pp, "torus",
+                                       {"torus_center", "torus_small_radius", "torus_large_radius"}));
     }
     else
     {
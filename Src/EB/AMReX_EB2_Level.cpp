@@ -1,7 +1,10 @@
 
 #include <AMReX_EB2_Level.H>
 #include <AMReX_IArrayBox.H>
+#include <AMReX_Utility.H>
 #include <algorithm>
+#include <fstream>
+#include <sstream>
 
 namespace amrex { namespace EB2 {
 
@@ -915,4 +918,144 @@ Level::fillLevelSet (MultiFab& levelset, const Geometry& geom) const
     }
 }
 
+void
+Level::write (const std::string& dir) const
+{
+    BL_PROFILE("EB2::Level::write()");
+
+    if (ParallelDescriptor::IOProcessor()) {
+        if (!amrex::UtilCreateDirectory(dir, 0755)) {
+            amrex::CreateDirectoryFailed(dir);
+        }
+    }
+    ParallelDescriptor::Barrier();
+
+    if (ParallelDescriptor::IOProcessor()) {
+        std::string hdr_name = dir + "/Header";
+        std::ofstream ofs(hdr_name.c_str());
+        if (!ofs.good()) amrex::FileOpenFailed(hdr_name);
+        ofs << m_allregular << " " << m_ok << "\n"
+            << m_ngrow << "\n"
+            << m_volfrac.nGrowVect() << " " << m_levelset.nGrowVect() << "\n";
+        // BoxArray::readFrom cannot read an empty BoxArray, so the sizes go first.
+        ofs << m_grids.size() << "\n";
+        if (!m_grids.empty()) {
+            m_grids.writeOn(ofs);
+            ofs << "\n";
+        }
+        ofs << m_covered_grids.size() << "\n";
+        if (!m_covered_grids.empty()) {
+            m_covered_grids.writeOn(ofs);
+            ofs << "\n";
+        }
+    }
+
+    if (m_allregular) return;
+
+    // Cell flags are stored as two 16-bit halves so that they are exact
+    // even in single precision.
+    MultiFab flag(m_grids, m_dmap, 2, m_cellflag.nGrowVect());
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(flag,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox();
+        auto const& fa = flag.array(mfi);
+        auto const& cflag = m_cellflag.const_array(mfi);
+        AMREX_HOST_DEVICE_FOR_3D(bx, i, j, k,
+        {
+            uint32_t v = cflag(i,j,k).getValue();
+            fa(i,j,k,0) = static_cast<Real>(v & 0xFFFFu);
+            fa(i,j,k,1) = static_cast<Real>(v >> 16);
+        });
+    }
+
+    VisMF::Write(flag, dir+"/CellFlag");
+    VisMF::Write(m_levelset, dir+"/LevelSet");
+    VisMF::Write(m_volfrac, dir+"/VolFrac");
+    VisMF::Write(m_centroid, dir+"/Centroid");
+    VisMF::Write(m_bndryarea, dir+"/BndryArea");
+    VisMF::Write(m_bndrycent, dir+"/BndryCent");
+    VisMF::Write(m_bndrynorm, dir+"/BndryNorm");
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        VisMF::Write(m_areafrac[idim], dir+"/AreaFrac_"+std::to_string(idim));
+        VisMF::Write(m_facecent[idim], dir+"/FaceCent_"+std::to_string(idim));
+        VisMF::Write(m_edgecent[idim], dir+"/EdgeCent_"+std::to_string(idim));
+    }
+}
+
+void
+Level::read (const std::string& dir)
+{
+    BL_PROFILE("EB2::Level::read()");
+
+    IntVect ng, ng_levelset;
+    {
+        Vector<char> file_chars;
+        ParallelDescriptor::ReadAndBcastFile(dir+"/Header", file_chars);
+        std::istringstream is(file_chars.dataPtr(), std::istringstream::in);
+        is >> m_allregular >> m_ok >> m_ngrow >> ng >> ng_levelset;
+        Long nboxes;
+        is >> nboxes;
+        if (nboxes > 0) m_grids.readFrom(is);
+        is >> nboxes;
+        if (nboxes > 0) m_covered_grids.readFrom(is);
+    }
+
+    if (m_allregular) {
+        m_grids = BoxArray();
+        m_dmap = DistributionMapping();
+        return;
+    }
+
+    m_dmap = DistributionMapping(m_grids);
+
+    MFInfo mf_info;
+    mf_info.SetTag("EB2::Level");
+
+    MultiFab flag(m_grids, m_dmap, 2, ng);
+    VisMF::Read(flag, dir+"/CellFlag");
+    m_cellflag.define(m_grids, m_dmap, 1, ng, mf_info);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(flag,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox();
+        auto const& fa = flag.const_array(mfi);
+        auto const& cflag = m_cellflag.array(mfi);
+        AMREX_HOST_DEVICE_FOR_3D(bx, i, j, k,
+        {
+            uint32_t lo = static_cast<uint32_t>(fa(i,j,k,0));
+            uint32_t hi = static_cast<uint32_t>(fa(i,j,k,1));
+            cflag(i,j,k) = EBCellFlag(lo | (hi << 16));
+        });
+    }
+
+    m_levelset.define(amrex::convert(m_grids,IntVect::TheNodeVector()), m_dmap, 1, ng_levelset, mf_info);
+    VisMF::Read(m_levelset, dir+"/LevelSet");
+    m_volfrac.define(m_grids, m_dmap, 1, ng, mf_info);
+    VisMF::Read(m_volfrac, dir+"/VolFrac");
+    m_centroid.define(m_grids, m_dmap, AMREX_SPACEDIM, ng, mf_info);
+    VisMF::Read(m_centroid, dir+"/Centroid");
+    m_bndryarea.define(m_grids, m_dmap, 1, ng, mf_info);
+    VisMF::Read(m_bndryarea, dir+"/BndryArea");
+    m_bndrycent.define(m_grids, m_dmap, AMREX_SPACEDIM, ng, mf_info);
+    VisMF::Read(m_bndrycent, dir+"/BndryCent");
+    m_bndrynorm.define(m_grids, m_dmap, AMREX_SPACEDIM, ng, mf_info);
+    VisMF::Read(m_bndrynorm, dir+"/BndryNorm");
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        m_areafrac[idim].define(amrex::convert(m_grids, IntVect::TheDimensionVector(idim)),
+                                m_dmap, 1, ng, mf_info);
+        VisMF::Read(m_areafrac[idim], dir+"/AreaFrac_"+std::to_string(idim));
+        m_facecent[idim].define(amrex::convert(m_grids, IntVect::TheDimensionVector(idim)),
+                                m_dmap, AMREX_SPACEDIM-1, ng, mf_info);
+        VisMF::Read(m_facecent[idim], dir+"/FaceCent_"+std::to_string(idim));
+        IntVect edge_type{1}; edge_type[idim] = 0;
+        m_edgecent[idim].define(amrex::convert(m_grids, edge_type), m_dmap, 1, ng, mf_info);
+        VisMF::Read(m_edgecent[idim], dir+"/EdgeCent_"+std::to_string(idim));
+    }
+}
+
 }}
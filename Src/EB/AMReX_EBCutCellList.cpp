@@ -0,0 +1,189 @@
+
+#include <AMReX_EBCutCellList.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_MultiCutFab.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_Scan.H>
+
+namespace amrex {
+
+MultiCutCellList::MultiCutCellList (const FabArray<EBCellFlagFab>& cellflags, int ngrow,
+                                    const MultiFab& volfrac, const MultiCutFab& centroid,
+                                    const MultiCutFab* bndryarea,
+                                    const MultiCutFab* bndrycent,
+                                    const MultiCutFab* bndrynorm)
+    : m_data(cellflags.boxArray(), cellflags.DistributionMap()),
+      m_ngrow(ngrow)
+{
+    BL_PROFILE("MultiCutCellList::MultiCutCellList()");
+
+    AMREX_ALWAYS_ASSERT(cellflags.nGrow() >= ngrow);
+
+    const bool has_bndry = bndryarea && bndrycent && bndrynorm;
+    m_ncomp = has_bndry ? CutCellComp::nfull : CutCellComp::nvolume;
+    const int ncomp = m_ncomp;
+
+    Long nbytes = 0;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion()) reduction(+:nbytes)
+#endif
+    for (MFIter mfi(m_data); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = amrex::grow(mfi.validbox(), ngrow);
+
+        // Only the volume fraction is allocated in regular and covered boxes.
+        // The other moments are stored where they exist, and get the default
+        // values elsewhere.
+        auto const& flag = cellflags.const_array(mfi);
+        auto const& vfrac = volfrac.const_array(mfi);
+        const Box vfbx = volfrac[mfi].box();
+        Array4<Real const> cent, barea, bcent, bnorm;
+        Box ctbx, bdbx;
+        if (centroid.ok(mfi)) {
+            cent = centroid.const_array(mfi);
+            ctbx = centroid[mfi].box();
+        }
+        if (has_bndry && bndryarea->ok(mfi)) {
+            barea = bndryarea->const_array(mfi);
+            bcent = bndrycent->const_array(mfi);
+            bnorm = bndrynorm->const_array(mfi);
+            bdbx = (*bndryarea)[mfi].box();
+        }
+
+        auto value = [=] AMREX_GPU_HOST_DEVICE (IntVect const& iv, int comp) noexcept -> Real
+        {
+            if (comp == CutCellComp::volfrac) {
+                if (vfbx.contains(iv)) { return vfrac(iv); }
+            } else if (comp < CutCellComp::bndryarea) {
+                if (ctbx.contains(iv)) { return cent(iv,comp-CutCellComp::centroid); }
+            } else if (comp == CutCellComp::bndryarea) {
+                if (bdbx.contains(iv)) { return barea(iv); }
+            } else if (comp < CutCellComp::bndrynorm) {
+                if (bdbx.contains(iv)) { return bcent(iv,comp-CutCellComp::bndrycent); }
+            } else {
+                if (bdbx.contains(iv)) { return bnorm(iv,comp-CutCellComp::bndrynorm); }
+            }
+            return CutCellComp::defaultValue(comp, flag(iv));
+        };
+
+        auto keep = [=] AMREX_GPU_HOST_DEVICE (IntVect const& iv) noexcept -> int
+        {
+            if (flag(iv).isSingleValued()) { return 1; }
+            for (int comp = 0; comp < ncomp; ++comp) {
+                if (value(iv,comp) != CutCellComp::defaultValue(comp, flag(iv))) {
+                    return 1;
+                }
+            }
+            return 0;
+        };
+
+        auto fill = [=] AMREX_GPU_HOST_DEVICE (IntVect const& iv, int x, int ncells,
+                                               IntVect* cells, Real* data) noexcept
+        {
+            cells[x] = iv;
+            for (int comp = 0; comp < ncomp; ++comp) {
+                data[x + comp*ncells] = value(iv,comp);
+            }
+        };
+
+        const int npts = static_cast<int>(bx.numPts());
+        CutCellList& ccl = m_data[mfi];
+        ccl.m_ncomp = ncomp;
+
+#ifdef AMREX_USE_GPU
+        if (Gpu::inLaunchRegion())
+        {
+            const int ncells = Reduce::Sum<int>(npts,
+                [=] AMREX_GPU_DEVICE (int i) -> int
+                {
+                    return keep(bx.atOffset(i));
+                });
+            ccl.m_cells.resize(ncells);
+            ccl.m_data.resize(static_cast<Long>(ncells)*ncomp);
+            IntVect* cells = ccl.m_cells.dataPtr();
+            Real* data = ccl.m_data.dataPtr();
+            Scan::PrefixSum<int>(npts,
+                [=] AMREX_GPU_DEVICE (int i) -> int
+                {
+                    return keep(bx.atOffset(i));
+                },
+                [=] AMREX_GPU_DEVICE (int i, int const& x)
+                {
+                    const IntVect iv = bx.atOffset(i);
+                    if (keep(iv)) {
+                        fill(iv, x, ncells, cells, data);
+                    }
+                },
+                Scan::Type::exclusive);
+        }
+        else
+#endif
+        {
+            int ncells = 0;
+            for (int i = 0; i < npts; ++i) {
+                ncells += keep(bx.atOffset(i));
+            }
+            ccl.m_cells.resize(ncells);
+            ccl.m_data.resize(static_cast<Long>(ncells)*ncomp);
+            IntVect* cells = ccl.m_cells.dataPtr();
+            Real* data = ccl.m_data.dataPtr();
+            int x = 0;
+            for (int i = 0; i < npts; ++i) {
+                const IntVect iv = bx.atOffset(i);
+                if (keep(iv)) {
+                    fill(iv, x++, ncells, cells, data);
+                }
+            }
+        }
+
+        nbytes += ccl.nBytes();
+    }
+
+    m_nbytes = nbytes;
+    FabArrayBase::updateMemUsage("MultiCutCellList", m_nbytes, nullptr);
+}
+
+MultiCutCellList::~MultiCutCellList ()
+{
+    FabArrayBase::updateMemUsage("MultiCutCellList", -m_nbytes, nullptr);
+}
+
+Long
+MultiCutCellList::numCutCells () const noexcept
+{
+    Long r = 0;
+    for (MFIter mfi(m_data); mfi.isValid(); ++mfi) {
+        r += m_data[mfi].size();
+    }
+    return r;
+}
+
+void
+MultiCutCellList::fill (const MFIter& mfi, const Box& bx, int comp, int ncomp,
+                        Array4<EBCellFlag const> const& flag,
+                        Array4<Real> const& a, int dcomp) const
+{
+    AMREX_ASSERT(comp >= 0 && comp+ncomp <= m_ncomp);
+    AMREX_ASSERT(amrex::grow(mfi.validbox(),m_ngrow).contains(bx));
+
+    amrex::ParallelFor(bx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    {
+        a(i,j,k,dcomp+n) = CutCellComp::defaultValue(comp+n, flag(i,j,k));
+    });
+
+    const CutCellListView view = m_data[mfi].const_view();
+    if (view.ncells > 0) {
+        amrex::ParallelFor(view.ncells, [=] AMREX_GPU_DEVICE (int icell) noexcept
+        {
+            const IntVect& iv = view.cell(icell);
+            if (bx.contains(iv)) {
+                for (int n = 0; n < ncomp; ++n) {
+                    a(iv,dcomp+n) = view(icell,comp+n);
+                }
+            }
+        });
+    }
+}
+
+}
@@ -2,8 +2,13 @@
 #include <AMReX_EBDataCollection.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_MultiCutFab.H>
+#include <AMReX_EBCutCellList.H>
 
 #include <AMReX_EB2_Level.H>
+#include <AMReX_EB2.H>
+#include <AMReX_OpenMP.H>
+
+#include <algorithm>
 
 namespace amrex {
 
@@ -19,6 +24,8 @@ EBDataCollection::EBDataCollection (const EB2::Level& a_level,
     // The BoxArray argument may not be cell-centered BoxArray.
     const BoxArray& a_ba = amrex::convert(a_ba_in, IntVect::TheZeroVector());
 
+    MultiFab::RegionTag ebdc_tag("EBDataCollection");
+
     if (m_support >= EBSupport::basic)
     {
         m_cellflags = new FabArray<EBCellFlagFab>(a_ba, a_dm, 1, m_ngrow[0], MFInfo(),
@@ -61,6 +68,62 @@ EBDataCollection::EBDataCollection (const EB2::Level& a_level,
         a_level.fillFaceCent(m_facecent, m_geom);
         a_level.fillEdgeCent(m_edgecent, m_geom);
     }
+
+    if (m_support >= EBSupport::volume && EB2::UseCutCellList())
+    {
+        buildCutCellList();
+    }
+}
+
+void
+EBDataCollection::buildCutCellList ()
+{
+    int ngrow = m_ngrow[1];
+    if (m_support == EBSupport::full) {
+        ngrow = std::max(ngrow, m_ngrow[2]);
+        m_cutcells = new MultiCutCellList(*m_cellflags, ngrow, *m_volfrac, *m_centroid,
+                                          m_bndryarea, m_bndrycent, m_bndrynorm);
+    } else {
+        m_cutcells = new MultiCutCellList(*m_cellflags, ngrow, *m_volfrac, *m_centroid);
+    }
+
+    // The lists hold everything needed to rebuild the dense cell moments,
+    // so free those.  The face and edge data stay dense.
+    delete m_volfrac;   m_volfrac = nullptr;
+    delete m_centroid;  m_centroid = nullptr;
+    delete m_bndrycent; m_bndrycent = nullptr;
+    delete m_bndryarea; m_bndryarea = nullptr;
+    delete m_bndrynorm; m_bndrynorm = nullptr;
+}
+
+void
+EBDataCollection::fillFromCutCellList (MultiFab& mf, int comp) const
+{
+    const int ncomp = mf.nComp();
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        m_cutcells->fill(mfi, mfi.fabbox(), comp, ncomp, m_cellflags->const_array(mfi),
+                         mf.array(mfi));
+    }
+}
+
+void
+EBDataCollection::fillFromCutCellList (MultiCutFab& mf, int comp) const
+{
+    const int ncomp = mf.nComp();
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(mf.data()); mfi.isValid(); ++mfi)
+    {
+        if (mf.ok(mfi)) {
+            m_cutcells->fill(mfi, mfi.fabbox(), comp, ncomp, m_cellflags->const_array(mfi),
+                             mf.array(mfi));
+        }
+    }
 }
 
 EBDataCollection::~EBDataCollection ()
@@ -68,6 +131,7 @@ EBDataCollection::~EBDataCollection ()
     delete m_cellflags;
     delete m_volfrac;
     delete m_centroid;
+    delete m_cutcells;
     delete m_bndrycent;
     delete m_bndrynorm;
     delete m_bndryarea;
@@ -88,6 +152,15 @@ EBDataCollection::getMultiEBCellFlagFab () const
 const MultiFab&
 EBDataCollection::getVolFrac () const
 {
+    if (m_volfrac == nullptr && m_cutcells != nullptr)
+    {
+        AMREX_ALWAYS_ASSERT(!OpenMP::in_parallel());
+        MultiFab::RegionTag ebdc_tag("EBDataCollection");
+        const BoxArray& ba = m_cellflags->boxArray();
+        const DistributionMapping& dm = m_cellflags->DistributionMap();
+        m_volfrac = new MultiFab(ba, dm, 1, m_ngrow[1], MFInfo(), FArrayBoxFactory());
+        fillFromCutCellList(*m_volfrac, CutCellComp::volfrac);
+    }
     AMREX_ASSERT(m_volfrac != nullptr);
     return *m_volfrac;
 }
@@ -95,13 +168,39 @@ EBDataCollection::getVolFrac () const
 const MultiCutFab&
 EBDataCollection::getCentroid () const
 {
+    if (m_centroid == nullptr && m_cutcells != nullptr)
+    {
+        AMREX_ALWAYS_ASSERT(!OpenMP::in_parallel());
+        MultiFab::RegionTag ebdc_tag("EBDataCollection");
+        const BoxArray& ba = m_cellflags->boxArray();
+        const DistributionMapping& dm = m_cellflags->DistributionMap();
+        m_centroid = new MultiCutFab(ba, dm, AMREX_SPACEDIM, m_ngrow[1], *m_cellflags);
+        fillFromCutCellList(*m_centroid, CutCellComp::centroid);
+    }
     AMREX_ASSERT(m_centroid != nullptr);
     return *m_centroid;
 }
 
+const MultiCutCellList&
+EBDataCollection::getCutCells () const
+{
+    AMREX_ASSERT(m_cutcells != nullptr);
+    return *m_cutcells;
+}
+
 const MultiCutFab&
 EBDataCollection::getBndryCent () const
 {
+    if (m_bndrycent == nullptr && m_cutcells != nullptr)
+    {
+        AMREX_ALWAYS_ASSERT(!OpenMP::in_parallel());
+        MultiFab::RegionTag ebdc_tag("EBDataCollection");
+        const BoxArray& ba = m_cellflags->boxArray();
+        const DistributionMapping& dm = m_cellflags->DistributionMap();
+        AMREX_ALWAYS_ASSERT(m_support == EBSupport::full);
+        m_bndrycent = new MultiCutFab(ba, dm, AMREX_SPACEDIM, m_ngrow[2], *m_cellflags);
+        fillFromCutCellList(*m_bndrycent, CutCellComp::bndrycent);
+    }
     AMREX_ASSERT(m_bndrycent != nullptr);
     return *m_bndrycent;
 }
@@ -109,6 +208,16 @@ EBDataCollection::getBndryCent () const
 const MultiCutFab&
 EBDataCollection::getBndryArea () const
 {
+    if (m_bndryarea == nullptr && m_cutcells != nullptr)
+    {
+        AMREX_ALWAYS_ASSERT(!OpenMP::in_parallel());
+        MultiFab::RegionTag ebdc_tag("EBDataCollection");
+        const BoxArray& ba = m_cellflags->boxArray();
+        const DistributionMapping& dm = m_cellflags->DistributionMap();
+        AMREX_ALWAYS_ASSERT(m_support == EBSupport::full);
+        m_bndryarea = new MultiCutFab(ba, dm, 1, m_ngrow[2], *m_cellflags);
+        fillFromCutCellList(*m_bndryarea, CutCellComp::bndryarea);
+    }
     AMREX_ASSERT(m_bndryarea != nullptr);
     return *m_bndryarea;
 }
@@ -137,6 +246,16 @@ EBDataCollection::getEdgeCent () const
 const MultiCutFab&
 EBDataCollection::getBndryNormal () const
 {
+    if (m_bndrynorm == nullptr && m_cutcells != nullptr)
+    {
+        AMREX_ALWAYS_ASSERT(!OpenMP::in_parallel());
+        MultiFab::RegionTag ebdc_tag("EBDataCollection");
+        const BoxArray& ba = m_cellflags->boxArray();
+        const DistributionMapping& dm = m_cellflags->DistributionMap();
+        AMREX_ALWAYS_ASSERT(m_support == EBSupport::full);
+        m_bndrynorm = new MultiCutFab(ba, dm, AMREX_SPACEDIM, m_ngrow[2], *m_cellflags);
+        fillFromCutCellList(*m_bndrynorm, CutCellComp::bndrynorm);
+    }
     AMREX_ASSERT(m_bndrynorm != nullptr);
     return *m_bndrynorm;
 }
@@ -7,6 +7,7 @@
 #include <AMReX_EBMultiFabUtil_C.H>
 #include <AMReX_EBCellFlag.H>
 #include <AMReX_MultiCutFab.H>
+#include <AMReX_EBCutCellList.H>
 
 #include <AMReX_VisMF.H>
 
@@ -17,6 +18,31 @@
 namespace amrex
 {
 
+namespace {
+
+// Cell moments [comp,comp+ncomp) of the box of mfi on bx.  With the cut
+// cell lists (eb2.cut_cell_list), the dense data do not exist and the
+// moments are filled into tmp, which eli keeps alive until the kernels
+// using it are done.
+template <class MF>
+Array4<Real const>
+cellMoments (EBFArrayBoxFactory const& factory, MF const* dense, MFIter const& mfi,
+             Box const& bx, int comp, int ncomp, FArrayBox& tmp, Elixir& eli)
+{
+    if (factory.hasCutCells()) {
+        tmp.resize(bx, ncomp);
+        eli = tmp.elixir();
+        factory.getCutCells().fill(mfi, bx, comp, ncomp,
+                                   factory.getMultiEBCellFlagFab().const_array(mfi),
+                                   tmp.array());
+        return tmp.const_array();
+    } else {
+        return dense->const_array(mfi);
+    }
+}
+
+}
+
 void
 EB_set_covered (MultiFab& mf, Real val)
 {
@@ -408,7 +434,7 @@ EB_average_down (const MultiFab& S_fine, MultiFab& S_crse, int scomp, int ncomp,
         Dim3 dratio = ratio.dim3();
 
         const auto& factory = dynamic_cast<EBFArrayBoxFactory const&>(S_fine.Factory());
-        const auto& vfrac_fine = factory.getVolFrac();
+        MultiFab const* vfrac_fine = factory.hasCutCells() ? nullptr : &factory.getVolFrac();
 
         BL_ASSERT(S_crse.nComp() == S_fine.nComp());
         BL_ASSERT(S_crse.is_cell_centered() && S_fine.is_cell_centered());
@@ -442,7 +468,11 @@ EB_average_down (const MultiFab& S_fine, MultiFab& S_crse, int scomp, int ncomp,
                 }
                 else
                 {
-                    Array4<Real const> const& vfrc = vfrac_fine.const_array(mfi);
+                    FArrayBox vftmp;
+                    Elixir vfeli;
+                    Array4<Real const> const& vfrc
+                        = cellMoments(factory, vfrac_fine, mfi, amrex::refine(tbx,ratio),
+                                      CutCellComp::volfrac, 1, vftmp, vfeli);
                     AMREX_HOST_DEVICE_FOR_3D(tbx, i, j, k,
                     {
                         eb_avgdown(i,j,k,fine,scomp,crse,scomp,vfrc,dratio,ncomp);
@@ -479,7 +509,11 @@ EB_average_down (const MultiFab& S_fine, MultiFab& S_crse, int scomp, int ncomp,
                 }
                 else if (typ == FabType::singlevalued)
                 {
-                    Array4<Real const> const& vfrc = vfrac_fine.const_array(mfi);
+                    FArrayBox vftmp;
+                    Elixir vfeli;
+                    Array4<Real const> const& vfrc
+                        = cellMoments(factory, vfrac_fine, mfi, amrex::refine(tbx,ratio),
+                                      CutCellComp::volfrac, 1, vftmp, vfeli);
                     AMREX_HOST_DEVICE_FOR_3D(tbx, i, j, k,
                     {
                         eb_avgdown(i,j,k,fine_arr,scomp,crse_arr,0,vfrc,dratio,ncomp);
@@ -637,7 +671,7 @@ void EB_average_down_boundaries (const MultiFab& fine, MultiFab& crse,
 
         const auto& factory = dynamic_cast<EBFArrayBoxFactory const&>(fine.Factory());
         const auto& flags = factory.getMultiEBCellFlagFab();
-        const auto& barea = factory.getBndryArea();
+        MultiCutFab const* barea = factory.hasCutCells() ? nullptr : &factory.getBndryArea();
 
         if (isMFIterSafe(fine, crse))
         {
@@ -658,7 +692,11 @@ void EB_average_down_boundaries (const MultiFab& fine, MultiFab& crse,
                     });
                 } else {
                     Array4<Real const> const& fa = fine.const_array(mfi);
-                    Array4<Real const> const& ba = barea.const_array(mfi);
+                    FArrayBox batmp;
+                    Elixir baeli;
+                    Array4<Real const> const& ba
+                        = cellMoments(factory, barea, mfi, amrex::refine(tbx,ratio),
+                                      CutCellComp::bndryarea, 1, batmp, baeli);
                     AMREX_HOST_DEVICE_FOR_3D(tbx,i,j,k,
                     {
                         eb_avgdown_boundaries(i,j,k,fa,0,ca,0,ba,dratio,ncomp);
@@ -695,7 +733,7 @@ void EB_computeDivergence (MultiFab& divu, const Array<MultiFab const*,AMREX_SPA
     {
         const auto& factory = dynamic_cast<EBFArrayBoxFactory const&>(divu.Factory());
         const auto& flags = factory.getMultiEBCellFlagFab();
-        const auto& vfrac = factory.getVolFrac();
+        MultiFab const* vfrac = factory.hasCutCells() ? nullptr : &factory.getVolFrac();
         const auto& area = factory.getAreaFrac();
         const auto& fcent = factory.getFaceCent();
 
@@ -734,7 +772,11 @@ void EB_computeDivergence (MultiFab& divu, const Array<MultiFab const*,AMREX_SPA
             } else {
                 Array4<int const> const& ccm = (already_on_centroids) ?
                     Array4<int const>{} : cc_mask.const_array(mfi);
-                Array4<Real const> const& vol = vfrac.const_array(mfi);
+                FArrayBox vftmp;
+                Elixir vfeli;
+                Array4<Real const> const& vol = cellMoments(factory, vfrac, mfi, bx,
+                                                            CutCellComp::volfrac, 1,
+                                                            vftmp, vfeli);
                 AMREX_D_TERM(Array4<Real const> const& apx = area[0]->const_array(mfi);,
                              Array4<Real const> const& apy = area[1]->const_array(mfi);,
                              Array4<Real const> const& apz = area[2]->const_array(mfi));
@@ -813,7 +855,8 @@ EB_interp_CC_to_Centroid (MultiFab& cent, const MultiFab& cc, int scomp, int dco
 {
     const auto& factory = dynamic_cast<EBFArrayBoxFactory const&>(cc.Factory());
     const auto& flags = factory.getMultiEBCellFlagFab();
-    const auto& loc = factory.getCentroid();
+    const bool use_cutcell_list = factory.hasCutCells();
+    MultiCutFab const* loc = use_cutcell_list ? nullptr : &factory.getCentroid();
 
     MFItInfo mfi_info;
     if (Gpu::notInLaunchRegion()) mfi_info.SetDynamic(true);
@@ -841,10 +884,10 @@ EB_interp_CC_to_Centroid (MultiFab& cent, const MultiFab& cc, int scomp, int dco
                centfab(i,j,k,n) = ccfab(i,j,k,n);
             });
         }
-        else
+        else if (!use_cutcell_list)
         {
             const auto& flagfab = flags.const_array(mfi);
-            const auto& locfab = loc.const_array(mfi);
+            const auto& locfab = loc->const_array(mfi);
             const auto& ccfab = cc.array(mfi,scomp);
 
             AMREX_LAUNCH_HOST_DEVICE_LAMBDA ( vbx, thread_box,
@@ -852,6 +895,38 @@ EB_interp_CC_to_Centroid (MultiFab& cent, const MultiFab& cc, int scomp, int dco
                 eb_interp_cc2cent(thread_box, centfab, ccfab, flagfab, locfab, ncomp);
             });
         }
+        else
+        {
+            // Only the cut cells need to be interpolated.
+            const auto& ccfab = cc.const_array(mfi,scomp);
+            AMREX_HOST_DEVICE_PARALLEL_FOR_4D ( vbx, ncomp, i, j, k, n,
+            {
+                centfab(i,j,k,n) = ccfab(i,j,k,n);
+            });
+
+            // The lists also hold ghost cells and a few cells that are not cut.
+            const auto& flagfab = flags.const_array(mfi);
+            const auto& cutcells = factory.getCutCells().const_view(mfi);
+            amrex::ParallelFor(cutcells.ncells, [=] AMREX_GPU_DEVICE (int icell) noexcept
+            {
+                const IntVect& iv = cutcells.cell(icell);
+                if (!vbx.contains(iv) || flagfab(iv).isCovered() || flagfab(iv).isRegular()) {
+                    return;
+                }
+                for (int n = 0; n < ncomp; ++n) {
+#if (AMREX_SPACEDIM == 2)
+                    centfab(iv,n) = eb_interp_cc2cent_cut(iv[0], iv[1], 0, n, ccfab,
+                                                          cutcells(icell,CutCellComp::centroid  ),
+                                                          cutcells(icell,CutCellComp::centroid+1));
+#else
+                    centfab(iv,n) = eb_interp_cc2cent_cut(iv[0], iv[1], iv[2], n, ccfab,
+                                                          cutcells(icell,CutCellComp::centroid  ),
+                                                          cutcells(icell,CutCellComp::centroid+1),
+                                                          cutcells(icell,CutCellComp::centroid+2));
+#endif
+                }
+            });
+        }
     }
 
     cent.FillBoundary(dcomp,ncomp,geom.periodicity());
@@ -1005,10 +1080,11 @@ EB_interp_CellCentroid_to_FaceCentroid (const MultiFab& phi_centroid,
 {
     const auto& factory = dynamic_cast<EBFArrayBoxFactory const&>(phi_centroid.Factory());
     const auto& flags = factory.getMultiEBCellFlagFab();
-    const auto& vfrac = factory.getVolFrac();
+    const bool use_cutcell_list = factory.hasCutCells();
+    MultiFab const* vfrac = use_cutcell_list ? nullptr : &factory.getVolFrac();
     const auto& area  = factory.getAreaFrac();
     const auto& fcent = factory.getFaceCent();
-    const auto& ccent = factory.getCentroid();
+    MultiCutFab const* ccent = use_cutcell_list ? nullptr : &factory.getCentroid();
 
     // We assume that we start from the first component of bcs ... we may need to generalize this
     AMREX_ALWAYS_ASSERT(a_bcs.size() >= ncomp );
@@ -1084,8 +1160,19 @@ EB_interp_CellCentroid_to_FaceCentroid (const MultiFab& phi_centroid,
                              Array4<Real const> const& fcy = fcent[1]->const_array(mfi);,
                              Array4<Real const> const& fcz = fcent[2]->const_array(mfi));
 
-                Array4<Real const> const& cvol = vfrac.const_array(mfi);
-                Array4<Real const> const& cct  = ccent.const_array(mfi);
+                // The interpolation reads the cell moments one cell beyond the faces.
+                Box mbx = amrex::grow(vbx,1);
+                if (use_cutcell_list) {
+                    mbx &= amrex::grow(mfi.validbox(), factory.getCutCells().nGrow());
+                }
+                FArrayBox vftmp, cttmp;
+                Elixir vfeli, cteli;
+                Array4<Real const> const& cvol = cellMoments(factory, vfrac, mfi, mbx,
+                                                             CutCellComp::volfrac, 1,
+                                                             vftmp, vfeli);
+                Array4<Real const> const& cct  = cellMoments(factory, ccent, mfi, mbx,
+                                                             CutCellComp::centroid, AMREX_SPACEDIM,
+                                                             cttmp, cteli);
 
                 AMREX_LAUNCH_HOST_DEVICE_LAMBDA_DIM
                     (xbx, txbx,
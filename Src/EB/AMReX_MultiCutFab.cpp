@@ -8,16 +8,56 @@
 
 namespace amrex {
 
+namespace {
+
+// Only allocates data for boxes with cut cells, so that no memory is ever
+// allocated for regular and covered boxes.
+class CutFabFactory
+    : public FabFactory<CutFab>
+{
+public:
+
+    explicit CutFabFactory (const FabArray<EBCellFlagFab>& cellflags)
+        : m_cellflags(&cellflags) {}
+
+    virtual CutFab* create (const Box& box, int ncomps, const FabInfo& info, int box_index) const override
+    {
+        if ((*m_cellflags)[box_index].getType() == FabType::singlevalued) {
+            return new CutFab(box, ncomps, info.alloc, info.shared, info.arena);
+        } else {
+            return new CutFab(info.arena);
+        }
+    }
+
+    virtual CutFab* create_alias (CutFab const& rhs, int scomp, int ncomp) const override
+    {
+        return new CutFab(rhs, amrex::make_alias, scomp, ncomp);
+    }
+
+    virtual void destroy (CutFab* fab) const override
+    {
+        delete fab;
+    }
+
+    virtual CutFabFactory* clone () const override {
+        return new CutFabFactory(*m_cellflags);
+    }
+
+private:
+
+    const FabArray<EBCellFlagFab>* m_cellflags;
+};
+
+}
+
 MultiCutFab::MultiCutFab ()
 {}
 
 MultiCutFab::MultiCutFab (const BoxArray& ba, const DistributionMapping& dm,
                           int ncomp, int ngrow, const FabArray<EBCellFlagFab>& cellflags)
-    : m_data(ba,dm,ncomp,ngrow,MFInfo(),DefaultFabFactory<CutFab>()),
+    : m_data(ba,dm,ncomp,ngrow,MFInfo(),CutFabFactory(cellflags)),
       m_cellflags(&cellflags)
-{
-    remove();
-}
+{}
 
 MultiCutFab::~MultiCutFab ()
 {}
@@ -26,23 +66,8 @@ void
 MultiCutFab::define (const BoxArray& ba, const DistributionMapping& dm,
                      int ncomp, int ngrow, const FabArray<EBCellFlagFab>& cellflags)
 {
-    m_data.define(ba,dm,ncomp,ngrow,MFInfo(),DefaultFabFactory<CutFab>()),
+    m_data.define(ba,dm,ncomp,ngrow,MFInfo(),CutFabFactory(cellflags));
     m_cellflags = &cellflags;
-    remove();
-}
-
-void
-MultiCutFab::remove ()
-{
-    for (MFIter mfi(m_data); mfi.isValid(); ++mfi)
-    {
-        if (!ok(mfi))
-        {
-            CutFab* p = &(m_data[mfi]);
-            delete p;
-            m_data.setFab(mfi, new CutFab(), false);
-        }
-    }
 }
 
 const CutFab&
@@ -146,8 +146,9 @@ extern "C" {
                         famrcore->octree_leaf_grids[lev] = BoxArray(bl);
                         update_dummy_mf = true;
                     }
-                    if (famrcore->octree_leaf_dmap[lev].ProcessorMap() != iproc) {
-                        famrcore->octree_leaf_dmap[lev] = DistributionMapping(iproc);
+                    DistributionMapping leaf_dmap(std::move(iproc));
+                    if (famrcore->octree_leaf_dmap[lev] != leaf_dmap) {
+                        famrcore->octree_leaf_dmap[lev] = leaf_dmap;
                         update_dummy_mf = true;
                     }
                     if (update_dummy_mf) {
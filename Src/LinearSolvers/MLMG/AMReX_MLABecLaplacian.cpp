@@ -1,6 +1,7 @@
 
 #include <AMReX_MLABecLaplacian.H>
 #include <AMReX_MultiFabUtil.H>
+#include <AMReX_ParallelReduce.H>
 
 #include <AMReX_MLABecLap_K.H>
 
@@ -98,6 +99,10 @@ MLABecLaplacian::setScalars (Real a, Real b) noexcept
 void
 MLABecLaplacian::setACoeffs (int amrlev, const MultiFab& alpha)
 {
+    if (m_reuse_rtol > 0.0 && m_user_coeffs_change < 0.0) {
+        m_pending_coeffs_change = std::max(m_pending_coeffs_change,
+                                           coeffsChange(m_a_coeffs[amrlev][0], alpha));
+    }
     MultiFab::Copy(m_a_coeffs[amrlev][0], alpha, 0, 0, 1, 0);
     m_needs_update = true;
 }
@@ -105,6 +110,10 @@ MLABecLaplacian::setACoeffs (int amrlev, const MultiFab& alpha)
 void
 MLABecLaplacian::setACoeffs (int amrlev, Real alpha)
 {
+    if (m_reuse_rtol > 0.0 && m_user_coeffs_change < 0.0) {
+        m_pending_coeffs_change = std::max(m_pending_coeffs_change,
+                                           coeffsChange(m_a_coeffs[amrlev][0], alpha, 0));
+    }
     m_a_coeffs[amrlev][0].setVal(alpha);
     m_needs_update = true;
 }
@@ -115,6 +124,12 @@ MLABecLaplacian::setBCoeffs (int amrlev,
 {
     const int ncomp = getNComp();
     AMREX_ALWAYS_ASSERT(beta[0]->nComp() == 1 || beta[0]->nComp() == ncomp);
+    if (m_reuse_rtol > 0.0 && m_user_coeffs_change < 0.0) {
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            m_pending_coeffs_change = std::max(m_pending_coeffs_change,
+                                               coeffsChange(m_b_coeffs[amrlev][0][idim], *beta[idim]));
+        }
+    }
     if (beta[0]->nComp() == ncomp)
         for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
             for (int icomp = 0; icomp < ncomp; ++icomp) {
@@ -133,7 +148,14 @@ MLABecLaplacian::setBCoeffs (int amrlev,
 void
 MLABecLaplacian::setBCoeffs (int amrlev, Real beta)
 {
+    const int ncomp = getNComp();
     for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        if (m_reuse_rtol > 0.0 && m_user_coeffs_change < 0.0) {
+            for (int icomp = 0; icomp < ncomp; ++icomp) {
+                m_pending_coeffs_change = std::max(m_pending_coeffs_change,
+                                                   coeffsChange(m_b_coeffs[amrlev][0][idim], beta, icomp));
+            }
+        }
         m_b_coeffs[amrlev][0][idim].setVal(beta);
     }
     m_needs_update = true;
@@ -145,12 +167,82 @@ MLABecLaplacian::setBCoeffs (int amrlev, Vector<Real> const& beta)
     const int ncomp = getNComp();
     for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
         for (int icomp = 0; icomp < ncomp; ++icomp) {
+            if (m_reuse_rtol > 0.0 && m_user_coeffs_change < 0.0) {
+                m_pending_coeffs_change = std::max(m_pending_coeffs_change,
+                                                   coeffsChange(m_b_coeffs[amrlev][0][idim], beta[icomp], icomp));
+            }
             m_b_coeffs[amrlev][0][idim].setVal(beta[icomp]);
         }
     }
     m_needs_update = true;
 }
 
+Real
+MLABecLaplacian::coeffsChange (MultiFab const& oldc, MultiFab const& newc) const
+{
+    // In curvilinear coordinates the stored coefficients include the metric
+    // terms and cannot be compared with the new ones.
+    if (!m_geom[0][0].IsCartesian()) return std::numeric_limits<Real>::max();
+
+    const int ncomp = oldc.nComp();
+    const int nnew = newc.nComp();
+    Real r[2];
+    r[0] = amrex::ReduceMax(oldc, newc, 0,
+    [=] AMREX_GPU_HOST_DEVICE (Box const& bx, Array4<Real const> const& o,
+                               Array4<Real const> const& n) -> Real
+    {
+        Real dmax = 0.0;
+        AMREX_LOOP_4D(bx, ncomp, i, j, k, m,
+        {
+            dmax = amrex::max(dmax, std::abs(o(i,j,k,m) - n(i,j,k,(nnew == 1) ? 0 : m)));
+        });
+        return dmax;
+    });
+    r[1] = amrex::ReduceMax(oldc, 0,
+    [=] AMREX_GPU_HOST_DEVICE (Box const& bx, Array4<Real const> const& o) -> Real
+    {
+        Real omax = 0.0;
+        AMREX_LOOP_4D(bx, ncomp, i, j, k, m,
+        {
+            omax = amrex::max(omax, std::abs(o(i,j,k,m)));
+        });
+        return omax;
+    });
+    ParallelAllReduce::Max(r, 2, Communicator());
+
+    if (r[1] > 0.0) {
+        return r[0] / r[1];
+    } else {
+        return (r[0] > 0.0) ? std::numeric_limits<Real>::max() : Real(0.0);
+    }
+}
+
+Real
+MLABecLaplacian::coeffsChange (MultiFab const& oldc, Real newc, int comp) const
+{
+    if (!m_geom[0][0].IsCartesian()) return std::numeric_limits<Real>::max();
+
+    Real r[2];
+    r[0] = amrex::ReduceMax(oldc, 0,
+    [=] AMREX_GPU_HOST_DEVICE (Box const& bx, Array4<Real const> const& o) -> Real
+    {
+        Real dmax = 0.0;
+        AMREX_LOOP_3D(bx, i, j, k,
+        {
+            dmax = amrex::max(dmax, std::abs(o(i,j,k,comp) - newc));
+        });
+        return dmax;
+    });
+    r[1] = oldc.norm0(comp, 0, true);
+    ParallelAllReduce::Max(r, 2, Communicator());
+
+    if (r[1] > 0.0) {
+        return r[0] / r[1];
+    } else {
+        return (r[0] > 0.0) ? std::numeric_limits<Real>::max() : Real(0.0);
+    }
+}
+
 void
 MLABecLaplacian::averageDownCoeffs ()
 {
@@ -280,8 +372,19 @@ MLABecLaplacian::prepareForSolve ()
 
     averageDownCoeffs();
 
-    m_is_singular.clear();
-    m_is_singular.resize(m_num_amr_levels, false);
+    m_is_singular = singular_flags(false);
+
+    m_coeffs_change = 0.0;
+    m_pending_coeffs_change = 0.0;
+    m_user_coeffs_change = -1.0;
+    m_reused_coarse_data = false;
+    m_needs_update = false;
+}
+
+Vector<int>
+MLABecLaplacian::singular_flags (bool finest_mg) const
+{
+    Vector<int> is_singular(m_num_amr_levels, false);
     auto itlo = std::find(m_lobc[0].begin(), m_lobc[0].end(), BCType::Dirichlet);
     auto ithi = std::find(m_hibc[0].begin(), m_hibc[0].end(), BCType::Dirichlet);
     if (itlo == m_lobc[0].end() && ithi == m_hibc[0].end())
@@ -293,19 +396,20 @@ MLABecLaplacian::prepareForSolve ()
             {
                 if (m_a_scalar == 0.0)
                 {
-                    m_is_singular[alev] = true;
+                    is_singular[alev] = true;
                 }
                 else
                 {
-                    Real asum = m_a_coeffs[alev].back().sum();
-                    Real amax = m_a_coeffs[alev].back().norm0();
-                    m_is_singular[alev] = (asum <= amax * 1.e-12);
+                    const MultiFab& acoef = finest_mg ? m_a_coeffs[alev].front()
+                                                      : m_a_coeffs[alev].back();
+                    Real asum = acoef.sum();
+                    Real amax = acoef.norm0();
+                    is_singular[alev] = (asum <= amax * 1.e-12);
                 }
             }
         }
     }
-
-    m_needs_update = false;
+    return is_singular;
 }
 
 void
@@ -612,39 +716,46 @@ MLABecLaplacian::FFlux (Box const& box, Real const* dxinv, Real bscalar,
 void
 MLABecLaplacian::update ()
 {
-    if (MLCellABecLap::needsUpdate()) MLCellABecLap::update();
+    bool full_update = (m_reuse_rtol <= 0.0);
+
+    if (MLCellABecLap::needsUpdate()) {
+        MLCellABecLap::update();
+        full_update = true;
+    }
+
+    Real change = (m_user_coeffs_change >= 0.0) ? m_user_coeffs_change : m_pending_coeffs_change;
+    m_coeffs_change = (change >= std::numeric_limits<Real>::max() - m_coeffs_change)
+        ? std::numeric_limits<Real>::max() : m_coeffs_change + change;
+    m_pending_coeffs_change = 0.0;
+    m_user_coeffs_change = -1.0;
 
 #if (AMREX_SPACEDIM != 3)
     applyMetricTermsCoeffs();
 #endif
 
+    // The coarse coefficients have not been averaged down, so the new
+    // coefficients are checked on the finest multigrid level.  If that
+    // changes whether the problem is singular, the coarse data cannot
+    // be kept.
+    if (!full_update && m_coeffs_change <= m_reuse_rtol &&
+        singular_flags(true) == m_is_singular)
+    {
+        // Only the finest multigrid level of each AMR level has new
+        // coefficients.  The coarse levels and the bottom solver keep
+        // the operator of the last full update.
+        m_reused_coarse_data = true;
+        m_needs_update = false;
+        return;
+    }
+
     averageDownCoeffs();
 
-    m_is_singular.clear();
-    m_is_singular.resize(m_num_amr_levels, false);
-    auto itlo = std::find(m_lobc[0].begin(), m_lobc[0].end(), BCType::Dirichlet);
-    auto ithi = std::find(m_hibc[0].begin(), m_hibc[0].end(), BCType::Dirichlet);
-    if (itlo == m_lobc[0].end() && ithi == m_hibc[0].end())
-    {  // No Dirichlet
-        for (int alev = 0; alev < m_num_amr_levels; ++alev)
-        {
-            // For now this assumes that overset regions are treated as Dirichlet bc's
-            if (m_domain_covered[alev] && !m_overset_mask[alev][0]) 
-            {
-                if (m_a_scalar == 0.0)
-                {
-                    m_is_singular[alev] = true;
-                }
-                else
-                {
-                    Real asum = m_a_coeffs[alev].back().sum();
-                    Real amax = m_a_coeffs[alev].back().norm0();
-                    m_is_singular[alev] = (asum <= amax * 1.e-12);
-                }
-            }
-        }
-    }
+    m_is_singular = singular_flags(false);
 
+    m_coeffs_change = 0.0;
+    m_pending_coeffs_change = 0.0;
+    m_user_coeffs_change = -1.0;
+    m_reused_coarse_data = false;
     m_needs_update = false;
 }
 
@@ -747,7 +747,7 @@ MLLinOp::makeSubCommunicator (const DistributionMapping& dm)
 
 #ifdef BL_USE_MPI
 
-    Vector<int> newgrp_ranks = dm.ProcessorMap();
+    Vector<int> newgrp_ranks = dm.ProcessorMapCopy();
     std::sort(newgrp_ranks.begin(), newgrp_ranks.end());
     auto last = std::unique(newgrp_ranks.begin(), newgrp_ranks.end());
     newgrp_ranks.erase(last, newgrp_ranks.end());
@@ -850,7 +850,7 @@ MLLinOp::makeConsolidatedDMap (const Vector<BoxArray>& ba, Vector<DistributionMa
             factor *= ratio;
 
             const int nprocs = ParallelContext::NProcsSub();
-            const auto& pmap_fine = dm[i-1].ProcessorMap();
+            const auto pmap_fine = dm[i-1].ProcessorMapCopy();
             Vector<int> pmap(pmap_fine.size());
             ParallelContext::global_to_local_rank(pmap.data(), pmap_fine.data(), pmap.size()); 
             if (strategy == 1) {
@@ -901,7 +901,7 @@ MLLinOp::remapNeighborhoods (Vector<DistributionMapping> & dms)
 
     for (int j = 1; j < dms.size(); ++j)
     {
-        const Vector<int> & pmap = dms[j].ProcessorMap();
+        const Vector<int> pmap = dms[j].ProcessorMapCopy();
         std::set<int> g_ranks_set(pmap.begin(), pmap.end());
         auto lev_rank_n = g_ranks_set.size();
         if (lev_rank_n >= remap_nbh_lb && lev_rank_n < ParallelContext::NProcsSub())
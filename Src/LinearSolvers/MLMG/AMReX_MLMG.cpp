@@ -1145,16 +1145,19 @@ MLMG::prepareForSolve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab con
     } else if (linop.needsUpdate()) {
         linop.update();
 
+        if (!linop.reusedCoarseData())
+        {
 #if defined(AMREX_USE_HYPRE) && (AMREX_SPACEDIM > 1)
-        hypre_solver.reset();
-        hypre_bndry.reset();
-        hypre_node_solver.reset();
+            hypre_solver.reset();
+            hypre_bndry.reset();
+            hypre_node_solver.reset();
 #endif
 
 #ifdef AMREX_USE_PETSC
-        petsc_solver.reset(); 
-        petsc_bndry.reset(); 
+            petsc_solver.reset();
+            petsc_bndry.reset();
 #endif
+        }
     }
 
     sol.resize(namrlevs);
@@ -1649,7 +1652,7 @@ MLMG::averageDownAndSync ()
 void
 MLMG::computeVolInv ()
 {
-    if (solve_called) return;
+    if (solve_called && !volinv.empty()) return;
 
     if (linop.isCellCentered())
     { 
@@ -1,8 +1,190 @@
 #include <AMReX_ParticleUtil.H>
+#include <AMReX_Utility.H>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
 
 namespace amrex
 {
 
+void incrementalSortPermutation (const unsigned int* keys, int n, unsigned int* perm)
+{
+    BL_PROFILE("amrex::incrementalSortPermutation");
+
+    // A key is out of place if it is out of order with one of its
+    // neighbors.  The greedy pass then makes sure the keys that are left
+    // are in order, even if a whole run of them has been displaced.
+    std::vector<unsigned int> kept;
+    std::vector<unsigned int> moved;
+    kept.reserve(n);
+    for (int i = 0; i < n; ++i)
+    {
+        const bool out = (i > 0   && keys[i] < keys[i-1]) ||
+                         (i+1 < n && keys[i] > keys[i+1]) ||
+                         (!kept.empty() && keys[i] < keys[kept.back()]);
+        if (out) {
+            moved.push_back(i);
+        } else {
+            kept.push_back(i);
+        }
+    }
+
+    // Equal keys have to come out in their original order, but a moved key
+    // can belong before a kept one with the same key, so both the sort and
+    // the merge order by the key and then by the index.  The kept indices are
+    // already in that order.
+    auto by_key = [keys] (unsigned int a, unsigned int b) {
+        return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+    };
+    std::sort(moved.begin(), moved.end(), by_key);
+    std::merge(kept.begin(), kept.end(), moved.begin(), moved.end(), perm, by_key);
+}
+
+void readLineAlignedChunk (const std::string& file, Long data_begin,
+                           Long begin, Long end, Vector<char>& buffer)
+{
+    BL_PROFILE("amrex::readLineAlignedChunk");
+
+    buffer.clear();
+    if (begin >= end) return;
+
+    std::ifstream ifs(file.c_str(), std::ios::in | std::ios::binary);
+    if (!ifs.good()) amrex::FileOpenFailed(file);
+
+    // We also read the character before our range, to see whether a line
+    // starts right at begin.
+    const Long first = std::max(begin-1, data_begin);
+    buffer.resize(end - first);
+    ifs.seekg(first, std::ios::beg);
+    ifs.read(buffer.data(), buffer.size());
+    if (ifs.gcount() != static_cast<std::streamsize>(buffer.size())) {
+        amrex::Error("readLineAlignedChunk: failed to read " + file);
+    }
+
+    // The line that is cut at begin belongs to the previous range.
+    std::size_t start = 0;
+    if (first < begin)
+    {
+        auto nl = std::find(buffer.begin(), buffer.end(), '\n');
+        start = (nl == buffer.end()) ? buffer.size() : (nl - buffer.begin()) + 1;
+        if (start == buffer.size()) {
+            buffer.clear();
+            return;
+        }
+    }
+
+    // The line that is cut at end belongs to us; read on to its end.
+    if (buffer.back() != '\n')
+    {
+        char block[4096];
+        while (true)
+        {
+            ifs.read(block, sizeof(block));
+            const std::streamsize n = ifs.gcount();
+            if (n <= 0) break;
+            char* nl = std::find(block, block+n, '\n');
+            if (nl != block+n) {
+                buffer.insert(buffer.end(), block, nl+1);
+                break;
+            }
+            buffer.insert(buffer.end(), block, block+n);
+        }
+    }
+
+    buffer.erase(buffer.begin(), buffer.begin()+start);
+}
+
+bool parseParticleReal (const char*& p, const char* end, double& value)
+{
+    auto is_space = [] (char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+    auto is_digit = [] (char c) { return c >= '0' && c <= '9'; };
+
+    while (p < end && is_space(*p)) ++p;
+    if (p == end) return false;
+
+    const char* start = p;
+    const bool negative = (*p == '-');
+    if (*p == '-' || *p == '+') ++p;
+
+    // Accumulate up to 19 significant digits, which always fit in 64 bits.
+    std::uint64_t mantissa = 0;
+    int ndigits = 0;
+    int exponent = 0;
+    bool exact = true;
+    bool any = false;
+    for ( ; p < end && is_digit(*p); ++p)
+    {
+        any = true;
+        if (ndigits < 19) {
+            mantissa = mantissa*10 + (*p - '0');
+            if (mantissa > 0) ++ndigits;
+        } else {
+            ++exponent;
+            if (*p != '0') exact = false;
+        }
+    }
+    if (p < end && *p == '.')
+    {
+        for (++p; p < end && is_digit(*p); ++p)
+        {
+            any = true;
+            if (ndigits < 19) {
+                mantissa = mantissa*10 + (*p - '0');
+                if (mantissa > 0) ++ndigits;
+                --exponent;
+            } else if (*p != '0') {
+                exact = false;
+            }
+        }
+    }
+    if (any && p < end && (*p == 'e' || *p == 'E'))
+    {
+        const char* q = p+1;
+        bool eneg = false;
+        if (q < end && (*q == '-' || *q == '+')) eneg = (*q++ == '-');
+        if (q < end && is_digit(*q))
+        {
+            int e = 0;
+            for ( ; q < end && is_digit(*q); ++q) {
+                if (e < 100000) e = e*10 + (*q - '0');
+            }
+            exponent += eneg ? -e : e;
+            p = q;
+        }
+    }
+
+    // Both the mantissa and the power of ten are exact doubles here, so a
+    // single multiplication or division gives the correctly rounded result.
+    if (any && exact && mantissa <= (std::uint64_t(1) << 53) &&
+        exponent >= -22 && exponent <= 22 && (p == end || is_space(*p)))
+    {
+        static const double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                       1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                       1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        double v = static_cast<double>(mantissa);
+        v = (exponent < 0) ? v / pow10[-exponent] : v * pow10[exponent];
+        value = negative ? -v : v;
+        return true;
+    }
+
+    // Anything else (long mantissas, large exponents, inf, nan) goes
+    // through strtod, which needs a null-terminated copy of the token.
+    const char* token_end = start;
+    while (token_end < end && !is_space(*token_end)) ++token_end;
+    const std::string token(start, token_end);
+    char* stop = nullptr;
+    value = std::strtod(token.c_str(), &stop);
+    if (stop == token.c_str()) {
+        p = start;
+        return false;
+    }
+    p = start + (stop - token.c_str());
+    return true;
+}
+
 IntVect computeRefFac (const ParGDBBase* a_gdb, int src_lev, int lev)
 {
     IntVect ref_fac = IntVect(AMREX_D_DECL(1,1,1));
@@ -3,6 +3,11 @@
 #include "AMReX_TracerParticles.H"
 #include "AMReX_TracerParticle_mod_K.H"
 #include <AMReX_Print.H>
+#include <AMReX_AsyncOut.H>
+
+#include <memory>
+#include <numeric>
+
 namespace amrex {
 
 //
@@ -365,4 +370,309 @@ TracerParticleContainer::Timestamp (const std::string&      basename,
 #endif
     }
 }
+
+//
+// The binary time series in directory dir consists of
+//
+//   Header      -- version, AMREX_SPACEDIM, values per sample, sizeof(Real)
+//                  and the number of data files.
+//   Data_NNNNN  -- chunks of samples, each sorted by particle and then time.
+//   Index_NNNNN -- for every chunk in Data_NNNNN, its offset and the number
+//                  of particles, followed by the sorted (id, cpu) pairs and
+//                  the (first sample, number of samples) of each particle.
+//
+// The ranks are grouped into files as by AsyncOut::GetWriteInfo, and the
+// ranks of a file append their chunks in turn.
+//
+void
+TracerParticleContainer::TimestampBinary (const std::string&      dir,
+                                          const MultiFab&         mf,
+                                          int                     lev,
+                                          Real                    time,
+                                          const std::vector<int>& indices)
+{
+    BL_PROFILE("TracerParticleContainer::TimestampBinary()");
+    AMREX_ASSERT(lev >= 0);
+    AMREX_ASSERT(!dir.empty());
+    AMREX_ASSERT(lev <= m_gdb->finestLevel());
+
+    const auto strttime = amrex::second();
+
+    const int M      = indices.size();
+    const int nreals = 1 + 2*AMREX_SPACEDIM + M;
+
+    if (dir != m_ts_dir)
+    {
+        FlushTimestamps();
+
+        m_ts_dir    = dir;
+        m_ts_nreals = nreals;
+
+        ParmParse pp("particles");
+        pp.query("timestamp_chunk_size", m_ts_chunk_size);
+        m_ts_chunk_size = std::max(m_ts_chunk_size, 1);
+
+        if (ParallelDescriptor::IOProcessor())
+        {
+            if (!amrex::UtilCreateDirectory(dir, 0755))
+                amrex::CreateDirectoryFailed(dir);
+
+            const int NProcs = ParallelDescriptor::NProcs();
+            int nfiles = AsyncOut::GetWriteInfo(NProcs-1).ifile + 1;
+
+            const std::string HdrFileName = dir + "/Header";
+            if (amrex::FileExists(HdrFileName))
+            {
+                // We are appending to an existing time series.
+                std::ifstream HdrFile(HdrFileName.c_str());
+                std::string version;
+                int dim, old_nreals, real_size, old_nfiles;
+                HdrFile >> version >> dim >> old_nreals >> real_size >> old_nfiles;
+                if (dim != AMREX_SPACEDIM || old_nreals != nreals || real_size != sizeof(Real))
+                    amrex::Abort("TracerParticleContainer::TimestampBinary: " + dir +
+                                 " holds a different kind of time series");
+                nfiles = std::max(nfiles, old_nfiles);
+            }
+
+            std::ofstream HdrFile(HdrFileName.c_str(), std::ios::out|std::ios::trunc);
+            if (!HdrFile.good()) amrex::FileOpenFailed(HdrFileName);
+            HdrFile << "TracerTimestamp_V1\n" << AMREX_SPACEDIM << '\n' << nreals << '\n'
+                    << sizeof(Real) << '\n' << nfiles << '\n';
+        }
+        ParallelDescriptor::Barrier();
+    }
+
+    AMREX_ALWAYS_ASSERT(nreals == m_ts_nreals);
+
+    const BoxArray& ba = mf.boxArray();
+    std::vector<Real> vals(M);
+
+    for (const auto& kv : GetParticles(lev))
+    {
+        const int grid = kv.first.first;
+        const auto& pbox = kv.second.GetArrayOfStructs();
+        const Box&       bx  = ba[grid];
+        const FArrayBox& fab = mf[grid];
+
+        for (int k = 0; k < pbox.numParticles(); ++k)
+        {
+            const ParticleType& p = pbox[k];
+
+            if (p.id() <= 0) continue;
+
+            const IntVect& iv = Index(p,lev);
+
+            if (!bx.contains(iv) && !ba.contains(iv)) continue;
+
+            m_ts_ids.push_back(p.id());
+            m_ts_ids.push_back(p.cpu());
+
+            m_ts_reals.push_back(time);
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) m_ts_reals.push_back(p.pos(d));
+            //
+            // AdvectWithUmac stores the velocity in rdata ...
+            //
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) m_ts_reals.push_back(p.rdata(d));
+
+            if (M > 0)
+            {
+                ParticleType::Interp(p,m_gdb->Geom(lev),fab,&indices[0],&vals[0],M);
+                m_ts_reals.insert(m_ts_reals.end(), vals.begin(), vals.end());
+            }
+        }
+    }
+
+    if (++m_ts_nsamples >= m_ts_chunk_size) FlushTimestamps();
+
+    if (m_verbose > 1)
+    {
+        auto stoptime = amrex::second() - strttime;
+        ParallelDescriptor::ReduceRealMax(stoptime,ParallelDescriptor::IOProcessorNumber());
+        amrex::Print() << "TracerParticleContainer::TimestampBinary: lev: " << lev << " time: " << stoptime << '\n';
+    }
+}
+
+void
+TracerParticleContainer::FlushTimestamps ()
+{
+    if (m_ts_nsamples == 0) return;
+
+    BL_PROFILE("TracerParticleContainer::FlushTimestamps()");
+
+    const int  nreals = m_ts_nreals;
+    const Long nrecs  = m_ts_ids.size() / 2;
+
+    //
+    // Sort the samples by particle.  They were added in time order, so a
+    // stable sort keeps each particle's samples in time order.
+    //
+    Vector<Long> perm(nrecs);
+    std::iota(perm.begin(), perm.end(), Long(0));
+    const int* ids = m_ts_ids.data();
+    std::stable_sort(perm.begin(), perm.end(), [ids] (Long a, Long b) {
+        return std::make_pair(ids[2*a], ids[2*a+1]) < std::make_pair(ids[2*b], ids[2*b+1]);
+    });
+
+    auto data   = std::make_shared<Vector<Real> >(nrecs*nreals);
+    auto pids   = std::make_shared<Vector<int> >();
+    auto ranges = std::make_shared<Vector<Long> >();
+
+    for (Long i = 0; i < nrecs; ++i)
+    {
+        const Long j = perm[i];
+        std::copy(m_ts_reals.begin() + j*nreals, m_ts_reals.begin() + (j+1)*nreals,
+                  data->begin() + i*nreals);
+
+        if (pids->empty() || (*pids)[pids->size()-2] != ids[2*j] || pids->back() != ids[2*j+1])
+        {
+            pids->push_back(ids[2*j]);
+            pids->push_back(ids[2*j+1]);
+            ranges->push_back(i);
+            ranges->push_back(0);
+        }
+        ++ranges->back();
+    }
+
+    Vector<int>().swap(m_ts_ids);
+    Vector<Real>().swap(m_ts_reals);
+    m_ts_nsamples = 0;
+
+    const auto info = AsyncOut::GetWriteInfo(ParallelDescriptor::MyProc());
+    const std::string DataFileName  = amrex::Concatenate(m_ts_dir + "/Data_", info.ifile, 5);
+    const std::string IndexFileName = amrex::Concatenate(m_ts_dir + "/Index_", info.ifile, 5);
+
+    auto write_chunk = [=] ()
+    {
+        if (pids->empty()) return;
+
+        std::ofstream DataFile(DataFileName.c_str(), std::ios::out|std::ios::app|std::ios::binary);
+        DataFile.seekp(0, std::ios::end);
+        if (!DataFile.good()) amrex::FileOpenFailed(DataFileName);
+        const Long offset = DataFile.tellp();
+        DataFile.write((const char*)data->data(), data->size()*sizeof(Real));
+        DataFile.close();
+
+        std::ofstream IndexFile(IndexFileName.c_str(), std::ios::out|std::ios::app|std::ios::binary);
+        if (!IndexFile.good()) amrex::FileOpenFailed(IndexFileName);
+        const Long np = pids->size() / 2;
+        IndexFile.write((const char*)&offset, sizeof(Long));
+        IndexFile.write((const char*)&np, sizeof(Long));
+        IndexFile.write((const char*)pids->data(), pids->size()*sizeof(int));
+        IndexFile.write((const char*)ranges->data(), ranges->size()*sizeof(Long));
+        IndexFile.close();
+
+        if (!DataFile.good() || !IndexFile.good())
+            amrex::Abort("TracerParticleContainer::FlushTimestamps(): problem writing " + DataFileName);
+    };
+
+    if (AsyncOut::UseAsyncOut())
+    {
+        AsyncOut::Submit([=] ()
+        {
+            AsyncOut::Wait();  // Wait for my turn
+            write_chunk();
+            AsyncOut::Notify();  // Notify others I am done
+            // The next chunk appends to the same file, so no rank may go
+            // on until the last one has written this chunk.
+            AsyncOut::Barrier();
+        });
+    }
+    else
+    {
+        // The ranks of a file take turns.
+        const int nspots = AsyncOut::GetWriteInfo(0).nspots;
+        for (int ispot = 0; ispot < nspots; ++ispot)
+        {
+            if (ispot == info.ispot) write_chunk();
+            ParallelDescriptor::Barrier();
+        }
+    }
+}
+
+Vector<Real>
+TracerParticleContainer::ReadTimestampHistory (const std::string& dir, int id, int cpu)
+{
+    BL_PROFILE("TracerParticleContainer::ReadTimestampHistory()");
+
+    const std::string HdrFileName = dir + "/Header";
+    std::ifstream HdrFile(HdrFileName.c_str());
+    if (!HdrFile.good()) amrex::FileOpenFailed(HdrFileName);
+
+    std::string version;
+    int dim, nreals, real_size, nfiles;
+    HdrFile >> version >> dim >> nreals >> real_size >> nfiles;
+    if (version != "TracerTimestamp_V1" || dim != AMREX_SPACEDIM || real_size != sizeof(Real))
+        amrex::Abort("TracerParticleContainer::ReadTimestampHistory: cannot read " + dir);
+
+    Vector<Real> samples;
+    Vector<int>  pids;
+    Vector<Long> ranges;
+
+    for (int ifile = 0; ifile < nfiles; ++ifile)
+    {
+        const std::string IndexFileName = amrex::Concatenate(dir + "/Index_", ifile, 5);
+        if (!amrex::FileExists(IndexFileName)) continue;
+
+        std::ifstream IndexFile(IndexFileName.c_str(), std::ios::in|std::ios::binary);
+        std::ifstream DataFile;
+
+        Long offset, np;
+        while (IndexFile.read((char*)&offset, sizeof(Long)) &&
+               IndexFile.read((char*)&np, sizeof(Long)))
+        {
+            pids.resize(2*np);
+            ranges.resize(2*np);
+            IndexFile.read((char*)pids.data(), pids.size()*sizeof(int));
+            IndexFile.read((char*)ranges.data(), ranges.size()*sizeof(Long));
+            if (!IndexFile.good())
+                amrex::Abort("TracerParticleContainer::ReadTimestampHistory: problem reading " + IndexFileName);
+
+            // The particles of a chunk are sorted, so we can bisect.
+            Long lo = 0, hi = np;
+            while (lo < hi)
+            {
+                const Long mid = (lo + hi) / 2;
+                if (std::make_pair(pids[2*mid], pids[2*mid+1]) < std::make_pair(id, cpu)) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            if (lo == np || pids[2*lo] != id || pids[2*lo+1] != cpu) continue;
+
+            if (!DataFile.is_open())
+            {
+                const std::string DataFileName = amrex::Concatenate(dir + "/Data_", ifile, 5);
+                DataFile.open(DataFileName.c_str(), std::ios::in|std::ios::binary);
+                if (!DataFile.good()) amrex::FileOpenFailed(DataFileName);
+            }
+
+            const Long first = ranges[2*lo];
+            const Long count = ranges[2*lo+1];
+            const auto old_size = samples.size();
+            samples.resize(old_size + count*nreals);
+            DataFile.seekg(offset + first*nreals*sizeof(Real), std::ios::beg);
+            DataFile.read((char*)(samples.data() + old_size), count*nreals*sizeof(Real));
+        }
+    }
+
+    //
+    // A particle can move between ranks and hence files, so its samples
+    // from different files are put back in time order.
+    //
+    const Long nsamples = samples.size() / nreals;
+    Vector<Long> perm(nsamples);
+    std::iota(perm.begin(), perm.end(), Long(0));
+    std::stable_sort(perm.begin(), perm.end(), [&] (Long a, Long b) {
+        return samples[a*nreals] < samples[b*nreals];
+    });
+    Vector<Real> sorted(samples.size());
+    for (Long i = 0; i < nsamples; ++i) {
+        std::copy(samples.begin() + perm[i]*nreals, samples.begin() + (perm[i]+1)*nreals,
+                  sorted.begin() + i*nreals);
+    }
+
+    return sorted;
+}
+
 }
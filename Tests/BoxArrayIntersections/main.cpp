@@ -0,0 +1,227 @@
+
+#include <AMReX.H>
+#include <AMReX_Print.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_BoxList.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_Utility.H>
+#include <AMReX_MultiFab.H>
+
+using namespace amrex;
+
+void test ();
+void bench (const std::string& name, const BoxArray& ba, int nghost, int nrepeat);
+void memory (const Box& domain, int max_size, int nghost);
+void check_lattice (const BoxArray& ba, int nghost);
+void check_view (const BoxArray& ba, int nghost);
+
+int main(int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    test();
+    amrex::Finalize();
+}
+
+void test ()
+{
+    int n_cell = 256;
+    int small_size = 8;
+    int big_size = 128;
+    int nghost = 2;
+    int nrepeat = 5;
+    {
+        ParmParse pp;
+        pp.query("n_cell", n_cell);
+        pp.query("small_size", small_size);
+        pp.query("big_size", big_size);
+        pp.query("nghost", nghost);
+        pp.query("nrepeat", nrepeat);
+    }
+
+    const Box domain(IntVect(0), IntVect(n_cell-1));
+
+    // All boxes have the same size.
+    BoxArray uniform(domain);
+    uniform.maxSize(small_size);
+
+    // One big box in a corner of the domain and small boxes elsewhere, as
+    // after maxSize with mixed blocking factors.
+    const Box big(IntVect(0), IntVect(big_size-1));
+    BoxList bl(big);
+    for (int i = 0; i < uniform.size(); ++i) {
+        if (!big.contains(uniform[i])) {
+            bl.push_back(uniform[i]);
+        }
+    }
+    BoxArray onebig(std::move(bl));
+
+    // Boxes of sizes from small_size to big_size.
+    BoxList mixed_bl(domain);
+    mixed_bl.maxSize(big_size);
+    BoxList mixed_small;
+    int i = 0;
+    for (const Box& b : mixed_bl) {
+        BoxList tmp(b);
+        tmp.maxSize(std::max(small_size, big_size >> (i++ % 5)));
+        mixed_small.join(tmp);
+    }
+    BoxArray mixed(std::move(mixed_small));
+
+    AMREX_ALWAYS_ASSERT(uniform.isCompressed() && !onebig.isCompressed());
+    check_lattice(uniform, nghost);
+    check_view(onebig, nghost);
+
+    bench("uniform", uniform, nghost, nrepeat);
+    bench("one big", onebig, nghost, nrepeat);
+    bench("mixed", mixed, nghost, nrepeat);
+
+    amrex::Print() << "\nMemory per process in bytes\n";
+    for (int max_size = big_size; max_size >= small_size; max_size /= 2) {
+        memory(domain, max_size, nghost);
+    }
+}
+
+// Reports the memory used on each process by the metadata of a regular
+// decomposition of the domain, including the FillBoundary communication
+// metadata and the view of the local boxes and their neighbors it is built
+// from.  The maximum over the processes is printed.
+void memory (const Box& domain, int max_size, int nghost)
+{
+    BoxArray ba(domain);
+    ba.maxSize(max_size);
+    DistributionMapping dm(ba);
+    ba.intersections(ba[0]);
+
+    MultiFab mf(ba, dm, 1, nghost, MFInfo().SetAlloc(false));
+    const LocalBoxArrayView view(ba, mf.IndexArray(), IntVect(nghost),
+                                 Periodicity::NonPeriodic().shiftIntVect());
+
+    // The same boxes stored as a list, with the hash that intersections needs then.
+    BoxArray list = ba;
+    list.grow(0);
+    list.intersections(list[0]);
+
+    Vector<Long> bytes{ba.bytes(), list.bytes(), dm.bytes(), view.bytes(),
+                       mf.getFB(IntVect(nghost), Periodicity::NonPeriodic()).bytes()};
+    ParallelDescriptor::ReduceLongMax(bytes.data(), bytes.size(),
+                                      ParallelDescriptor::IOProcessorNumber());
+
+    amrex::Print() << std::setw(10) << ba.size() << " boxes:"
+                   << "  BoxArray " << std::setw(6) << bytes[0]
+                   << (ba.isCompressed() ? " (lattice)" : " (list)   ")
+                   << ", as a list " << std::setw(8) << bytes[1]
+                   << "  DistributionMapping " << std::setw(7) << bytes[2]
+                   << (dm.isCompressed() ? " (runs)" : " (list)")
+                   << "  local view " << std::setw(4) << bytes[3]
+                   << "  FillBoundary " << std::setw(9) << bytes[4] << "\n";
+}
+
+// Checks a compressed BoxArray against the same boxes stored as a list.
+void check_lattice (const BoxArray& ba, int nghost)
+{
+    BoxArray list = ba;
+    list.grow(0); // expands the lattice
+    AMREX_ALWAYS_ASSERT(!list.isCompressed() && list == ba && ba.bytes() < list.bytes());
+
+    std::vector<std::pair<int,Box> > isects, isects_list;
+    auto sorted = [] (std::vector<std::pair<int,Box> >& v) -> std::vector<std::pair<int,Box> >& {
+        std::sort(v.begin(), v.end(), [] (std::pair<int,Box> const& a, std::pair<int,Box> const& b)
+                  { return a.first < b.first; });
+        return v;
+    };
+    const IndexType nodal = IndexType::TheNodeType();
+    for (const BoxArray& crse : {amrex::coarsen(ba,2), amrex::convert(amrex::coarsen(ba,4),nodal)}) {
+        BoxArray crse_list = crse;
+        crse_list.grow(0);
+        for (int i = 0, N = crse.size(); i < N; ++i) {
+            const Box& gbx = amrex::grow(crse[i], nghost);
+            crse.intersections(gbx, isects);
+            crse_list.intersections(gbx, isects_list);
+            AMREX_ALWAYS_ASSERT(sorted(isects) == sorted(isects_list));
+            AMREX_ALWAYS_ASSERT(BoxArray(crse.complementIn(gbx)).numPts() ==
+                                BoxArray(crse_list.complementIn(gbx)).numPts());
+        }
+    }
+
+    // refine, coarsen and shift keep the lattice.
+    BoxArray moved = ba;
+    moved.refine(2).shift(IntVect(3));
+    list.refine(2).shift(IntVect(3));
+    AMREX_ALWAYS_ASSERT(moved.isCompressed() && moved == list);
+
+    DistributionMapping dm(ba);
+    const Vector<int> pmap = dm.ProcessorMapCopy();
+    for (int i = 0, N = ba.size(); i < N; ++i) {
+        AMREX_ALWAYS_ASSERT(dm[i] == pmap[i]);
+    }
+    AMREX_ALWAYS_ASSERT(dm == DistributionMapping(pmap));
+
+    amrex::Print() << "The lattice matches the list of boxes\n";
+}
+
+// Times the construction of the hash and the intersections of every grown
+// box with the BoxArray, and checks them against a brute-force search.
+void bench (const std::string& name, const BoxArray& ba, int nghost, int nrepeat)
+{
+    std::vector<std::pair<int,Box> > isects;
+
+    Real t0 = amrex::second();
+    ba.intersections(ba[0], isects);
+    const Real t_hash = amrex::second() - t0;
+
+    Long nisects = 0;
+    t0 = amrex::second();
+    for (int irepeat = 0; irepeat < nrepeat; ++irepeat) {
+        nisects = 0;
+        for (int i = 0, N = ba.size(); i < N; ++i) {
+            ba.intersections(amrex::grow(ba[i],nghost), isects);
+            nisects += isects.size();
+        }
+    }
+    const Real t_isects = (amrex::second() - t0) / nrepeat;
+
+    const int ncheck = std::min(static_cast<int>(ba.size()), 100);
+    Long nerrors = 0;
+    for (int i = 0; i < ncheck; ++i) {
+        const Box& gbx = amrex::grow(ba[i*(ba.size()/ncheck)],nghost);
+        ba.intersections(gbx, isects);
+        Long nbrute = 0;
+        for (int j = 0, N = ba.size(); j < N; ++j) {
+            nbrute += gbx.intersects(ba[j]);
+        }
+        nerrors += (nbrute != static_cast<Long>(isects.size()));
+    }
+
+    amrex::Print() << std::setw(8) << name << ": " << ba.size() << " boxes, "
+                   << nisects << " intersections\n"
+                   << "    hash " << t_hash << " s, intersections " << t_isects
+                   << " s, " << nerrors << " mismatches in " << ncheck << " checks\n";
+}
+
+// Checks the view of the local boxes and their neighbors against the full
+// BoxArray, and reports their memory.
+void check_view (const BoxArray& ba, int nghost)
+{
+    DistributionMapping dm(ba);
+    MultiFab mf(ba, dm, 1, nghost, MFInfo().SetAlloc(false));
+    const LocalBoxArrayView view(ba, mf.IndexArray(), IntVect(nghost),
+                                 Periodicity::NonPeriodic().shiftIntVect());
+
+    std::vector<std::pair<int,Box> > isects, isects_view;
+    for (const int i : mf.IndexArray()) {
+        const Box& gbx = amrex::grow(ba[i], nghost);
+        ba.intersections(gbx, isects);
+        view.intersections(gbx, isects_view);
+        std::sort(isects.begin(), isects.end(), [] (std::pair<int,Box> const& a, std::pair<int,Box> const& b)
+                  { return a.first < b.first; });
+        std::sort(isects_view.begin(), isects_view.end(), [] (std::pair<int,Box> const& a, std::pair<int,Box> const& b)
+                  { return a.first < b.first; });
+        AMREX_ALWAYS_ASSERT(isects == isects_view);
+    }
+
+    Vector<Long> bytes{ba.bytes(), view.bytes()};
+    ParallelDescriptor::ReduceLongMax(bytes.data(), bytes.size(),
+                                      ParallelDescriptor::IOProcessorNumber());
+    amrex::Print() << "The local view of " << ba.size() << " boxes matches the BoxArray: "
+                   << bytes[1] << " bytes against " << bytes[0] << " bytes per process\n";
+}
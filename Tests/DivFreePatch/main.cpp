@@ -138,10 +138,14 @@ void main_main ()
     amrex::Vector<int> f_lo(AMREX_SPACEDIM, 28);
     amrex::Vector<int> f_hi(AMREX_SPACEDIM,  4);
     int max_grid_size = 64;
+    int nrepeat = 0;
+    int ncomp_cc = 4;
 
     {
         ParmParse pp;
         pp.query("n_cell", n_cell);
+        pp.query("nrepeat", nrepeat);
+        pp.query("ncomp_cc", ncomp_cc);
         pp.query("f_offset", f_offset);
         pp.query("max_grid_size", max_grid_size);
         pp.query("nghost_c", nghost_c);
@@ -516,6 +520,110 @@ void main_main ()
                   amrex::VisMF::Write(f_mf_faces_wg[1], std::string("pltfiles/fwgyFP"));,
                   amrex::VisMF::Write(f_mf_faces_wg[2], std::string("pltfiles/fwgzFP"));  );
    
+// ***************************************************************
+//  Time repeated InterpFromCoarseLevel calls of the faces and of a
+//      cell-centered field, with and without cached stencils.
+
+    if (nrepeat > 0)
+    {
+        amrex::Print() << std::endl;
+        amrex::Print() << " ********************** " << std::endl;
+        amrex::Print() << " Timing " << nrepeat << " InterpFromCoarseLevel calls. " << std::endl;
+
+        Real time = 1;
+
+        Array<Vector<BCRec>, AMREX_SPACEDIM> bcrec_f;
+        Vector<BCRec> bcrec_c(ncomp_cc);
+        for (int odim=0; odim < AMREX_SPACEDIM; ++odim)
+        {
+            bcrec_f[odim].resize(ncomp);
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+            {
+                for (int n = 0; n < ncomp; ++n)
+                {
+                    bcrec_f[odim][n].setLo(idim, BCType::int_dir);
+                    bcrec_f[odim][n].setHi(idim, BCType::int_dir);
+                }
+            }
+        }
+        for (int n = 0; n < ncomp_cc; ++n)
+        {
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+            {
+                bcrec_c[n].setLo(idim, BCType::int_dir);
+                bcrec_c[n].setHi(idim, BCType::int_dir);
+            }
+        }
+
+        Array<MultiFab*, AMREX_SPACEDIM> fine_faces;
+        Array<MultiFab*, AMREX_SPACEDIM> coarse_faces;
+        for (int i=0; i<AMREX_SPACEDIM; ++i)
+        {
+            fine_faces[i] = &(f_mf_faces[i]);
+            coarse_faces[i] = &(c_mf_faces[i]);
+        }
+        Array<PhysBCFunctNoOp, AMREX_SPACEDIM> phys_bc_f;
+        PhysBCFunctNoOp phys_bc_c;
+
+        Real t0 = amrex::second();
+        for (int r = 0; r < nrepeat; ++r)
+        {
+            InterpFromCoarseLevel(fine_faces, time,
+                                  coarse_faces, 0, 0, 1,
+                                  c_geom, f_geom_all,
+                                  phys_bc_f, 0, phys_bc_f, 0,
+                                  ratio, &face_divfree_interp, bcrec_f, 0);
+        }
+        Real t_faces = amrex::second() - t0;
+
+        // Smooth multi-component data on the coarse cells.
+        MultiFab cc_coarse(div_coarse.boxArray(), div_coarse.DistributionMap(), ncomp_cc, 0);
+        for (MFIter mfi(cc_coarse); mfi.isValid(); ++mfi)
+        {
+            Array4<Real> const& arr = cc_coarse.array(mfi);
+            amrex::ParallelFor(mfi.validbox(), ncomp_cc,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+            {
+                arr(i,j,k,n) = std::sin(0.1*(n+1)*i) * std::cos(0.2*j) + 0.01*k*k;
+            });
+        }
+
+        MultiFab cc_fine(div_fine.boxArray(), div_fine.DistributionMap(), ncomp_cc, ghost_f);
+        MultiFab cc_fine_cached(div_fine.boxArray(), div_fine.DistributionMap(), ncomp_cc, ghost_f);
+
+        Array<Real,2> t_cc;
+        for (int cached = 0; cached < 2; ++cached)
+        {
+            cell_cons_interp.setStencilCaching(cached);
+            MultiFab& cc_dst = (cached) ? cc_fine_cached : cc_fine;
+            t0 = amrex::second();
+            for (int r = 0; r < nrepeat; ++r)
+            {
+                InterpFromCoarseLevel(cc_dst, time,
+                                      cc_coarse, 0, 0, ncomp_cc,
+                                      c_geom, f_geom_all,
+                                      phys_bc_c, 0, phys_bc_c, 0,
+                                      ratio, &cell_cons_interp, bcrec_c, 0);
+            }
+            t_cc[cached] = amrex::second() - t0;
+        }
+        cell_cons_interp.setStencilCaching(false);
+
+        ParallelDescriptor::ReduceRealMax(t_faces);
+        ParallelDescriptor::ReduceRealMax(t_cc.data(), 2);
+
+        amrex::Print() << " FaceDivFree time per call: " << t_faces/nrepeat << std::endl;
+        amrex::Print() << " CellConservativeLinear time per call: " << t_cc[0]/nrepeat
+                       << " (cached stencils: " << t_cc[1]/nrepeat << ")" << std::endl;
+        MultiFab::Subtract(cc_fine_cached, cc_fine, 0, 0, ncomp_cc, ghost_f);
+        Real cc_diff = 0;
+        for (int n = 0; n < ncomp_cc; ++n)
+        {
+            cc_diff = std::max(cc_diff, cc_fine_cached.norm0(n, nghost_f));
+        }
+        amrex::Print() << " Max difference with cached stencils: " << cc_diff << std::endl;
+    }
+
 // ***************************************************************
 
 }
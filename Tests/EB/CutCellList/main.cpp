@@ -0,0 +1,246 @@
+#include <AMReX.H>
+#include <AMReX_EB2.H>
+#include <AMReX_EB2_IF.H>
+#include <AMReX_EB2_Level.H>
+#include <AMReX_EBFabFactory.H>
+#include <AMReX_EBCutCellList.H>
+#include <AMReX_EBMultiFabUtil.H>
+#include <AMReX_EBMultiFabUtil_C.H>
+#include <AMReX_MultiFabUtil_C.H>
+#include <AMReX_MultiCutFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+namespace {
+
+// The dense EB data, filled directly from the EB2::Level.
+struct DenseData
+{
+    DenseData (const EB2::Level& level, const Geometry& geom,
+               const FabArray<EBCellFlagFab>& flags, int ng)
+    {
+        MultiFab::RegionTag tag("DenseEBData");
+        const BoxArray& ba = flags.boxArray();
+        const DistributionMapping& dm = flags.DistributionMap();
+        vfrac.define(ba, dm, 1, ng);
+        centroid.define(ba, dm, AMREX_SPACEDIM, ng, flags);
+        bndryarea.define(ba, dm, 1, ng, flags);
+        bndrycent.define(ba, dm, AMREX_SPACEDIM, ng, flags);
+        bndrynorm.define(ba, dm, AMREX_SPACEDIM, ng, flags);
+        level.fillVolFrac(vfrac, geom);
+        level.fillCentroid(centroid, geom);
+        level.fillBndryArea(bndryarea, geom);
+        level.fillBndryCent(bndrycent, geom);
+        level.fillBndryNorm(bndrynorm, geom);
+    }
+
+    MultiFab vfrac;
+    MultiCutFab centroid, bndryarea, bndrycent, bndrynorm;
+};
+
+void checkEqual (const FArrayBox& a, const FArrayBox& b, const Box& bx)
+{
+    const auto& x = a.const_array();
+    const auto& y = b.const_array();
+    amrex::LoopOnCpu(bx, a.nComp(), [&] (int i, int j, int k, int n) noexcept
+    {
+        AMREX_ALWAYS_ASSERT(x(i,j,k,n) == y(i,j,k,n));
+    });
+}
+
+// Every cut cell of the grown boxes is in the lists, and the lists of
+// regular and covered boxes are empty.
+void checkCutCells (const EBFArrayBoxFactory& factory)
+{
+    AMREX_ALWAYS_ASSERT(factory.hasCutCells());
+    const auto& cutcells = factory.getCutCells();
+    AMREX_ALWAYS_ASSERT(cutcells.nComp() == CutCellComp::nfull);
+    const auto& flags = factory.getMultiEBCellFlagFab();
+
+    Long ncut = 0;
+    for (MFIter mfi(flags); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = amrex::grow(mfi.validbox(), cutcells.nGrow());
+        const auto& list = cutcells[mfi];
+        if (flags[mfi].getType(bx) != FabType::singlevalued) {
+            AMREX_ALWAYS_ASSERT(list.empty() && list.nBytes() == 0);
+            continue;
+        }
+
+        // The lists live in device memory.
+        const CutCellListView view = list.const_view();
+        Gpu::HostVector<IntVect> cells(view.ncells);
+        Gpu::copy(Gpu::deviceToHost, view.cells, view.cells+view.ncells, cells.begin());
+
+        // The cells are in box order.
+        const auto& fl = flags.const_array(mfi);
+        int icell = 0;
+        amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+        {
+            const bool in_list = icell < view.ncells && cells[icell] == IntVect(AMREX_D_DECL(i,j,k));
+            if (in_list) { ++icell; }
+            if (fl(i,j,k).isSingleValued()) {
+                AMREX_ALWAYS_ASSERT(in_list);
+                ++ncut;
+            }
+        });
+        AMREX_ALWAYS_ASSERT(icell == view.ncells);
+    }
+
+    ParallelDescriptor::ReduceLongSum(ncut);
+    AMREX_ALWAYS_ASSERT(ncut > 0);
+    amrex::Print() << ncut << " cut cells are in the lists\n";
+}
+
+// The dense data rebuilt from the lists are the data of the EB2::Level.
+void checkRebuilt (const EBFArrayBoxFactory& factory, const DenseData& dense)
+{
+    const MultiFab& vfrac = factory.getVolFrac();
+    AMREX_ALWAYS_ASSERT(vfrac.nGrow() == dense.vfrac.nGrow());
+    for (MFIter mfi(vfrac); mfi.isValid(); ++mfi) {
+        checkEqual(vfrac[mfi], dense.vfrac[mfi], mfi.fabbox());
+    }
+
+    std::array<std::pair<const MultiCutFab*, const MultiCutFab*>,4> mcfs
+        {{ {&factory.getCentroid(),    &dense.centroid},
+           {&factory.getBndryArea(),   &dense.bndryarea},
+           {&factory.getBndryCent(),   &dense.bndrycent},
+           {&factory.getBndryNormal(), &dense.bndrynorm} }};
+    for (const auto& p : mcfs) {
+        for (MFIter mfi(p.first->data()); mfi.isValid(); ++mfi) {
+            AMREX_ALWAYS_ASSERT(p.first->ok(mfi) == p.second->ok(mfi));
+            if (p.first->ok(mfi)) {
+                checkEqual((*p.first)[mfi], (*p.second)[mfi], mfi.fabbox());
+            }
+        }
+    }
+    amrex::Print() << "The data rebuilt from the lists match the dense data\n";
+}
+
+void fillTestData (MultiFab& mf, const Geometry& geom)
+{
+    const auto dx = geom.CellSizeArray();
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        const auto& a = mf.array(mfi);
+        amrex::ParallelFor(mfi.fabbox(), mf.nComp(), [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            amrex::ignore_unused(k);
+            a(i,j,k,n) = std::sin((n+1)*i*dx[0]) + std::cos(j*dx[1]) + AMREX_D_PICK(0., 0., k*dx[2]);
+        });
+    }
+}
+
+// EB_interp_CC_to_Centroid with the lists must give the dense result.
+void checkInterp (const EBFArrayBoxFactory& factory, const DenseData& dense, const Geometry& geom)
+{
+    const BoxArray& ba = factory.boxArray();
+    const DistributionMapping& dm = factory.DistributionMap();
+    const int ncomp = 2;
+
+    MultiFab cc(ba, dm, ncomp, 1, MFInfo(), factory);
+    fillTestData(cc, geom);
+
+    MultiFab cent(ba, dm, ncomp, 0, MFInfo(), factory);
+    EB_interp_CC_to_Centroid(cent, cc, 0, 0, ncomp, geom);
+
+    const auto& flags = factory.getMultiEBCellFlagFab();
+    FArrayBox d;
+    for (MFIter mfi(cc); mfi.isValid(); ++mfi)
+    {
+        const Box& vbx = mfi.validbox();
+        if (flags[mfi].getType(vbx) != FabType::singlevalued) continue;
+        d.resize(vbx, ncomp);
+        eb_interp_cc2cent(vbx, d.array(), cc.const_array(mfi), flags.const_array(mfi),
+                          dense.centroid.const_array(mfi), ncomp);
+        checkEqual(cent[mfi], d, vbx);
+    }
+    amrex::Print() << "EB_interp_CC_to_Centroid matches the dense kernel\n";
+}
+
+// EB_average_down with the lists must give the dense result.
+void checkAverageDown (const EBFArrayBoxFactory& factory, const DenseData& dense, const Geometry& geom)
+{
+    const BoxArray& ba = factory.boxArray();
+    const DistributionMapping& dm = factory.DistributionMap();
+    const int ncomp = 2;
+    const IntVect ratio(2);
+
+    MultiFab fine(ba, dm, ncomp, 0, MFInfo(), factory);
+    fillTestData(fine, geom);
+
+    MultiFab crse(amrex::coarsen(ba,ratio), dm, ncomp, 0);
+    EB_average_down(fine, crse, 0, ncomp, ratio);
+
+    const auto& flags = factory.getMultiEBCellFlagFab();
+    FArrayBox d;
+    for (MFIter mfi(crse); mfi.isValid(); ++mfi)
+    {
+        const Box& cbx = mfi.validbox();
+        if (flags[mfi].getType(amrex::refine(cbx,ratio)) != FabType::singlevalued) continue;
+        d.resize(cbx, ncomp);
+        const auto& c = d.array();
+        const auto& f = fine.const_array(mfi);
+        const auto& vf = dense.vfrac.const_array(mfi);
+        amrex::LoopOnCpu(cbx, [&] (int i, int j, int k) noexcept
+        {
+            eb_avgdown(i,j,k,f,0,c,0,vf,ratio.dim3(),ncomp);
+        });
+        checkEqual(crse[mfi], d, cbx);
+    }
+    amrex::Print() << "EB_average_down matches the dense kernel\n";
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int n_cell = 64;
+        int max_grid_size = 16;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+        AMREX_ALWAYS_ASSERT(EB2::UseCutCellList());
+
+        const Box domain(IntVect(0), IntVect(n_cell-1));
+        RealBox rb({AMREX_D_DECL(-1.,-1.,-1.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Geometry geom(domain, rb, 0, {AMREX_D_DECL(0,0,0)});
+
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        EB2::SphereIF s1(0.5, {AMREX_D_DECL(0.1,0.0,-0.05)}, false);
+        EB2::SphereIF s2(0.3, {AMREX_D_DECL(-0.55,0.5,0.45)}, false);
+        EB2::Build(EB2::makeShop(EB2::makeUnion(s1,s2)), geom, 0, 0);
+
+        const int ng = 2;
+        auto factory = makeEBFabFactory(geom, ba, dm, {ng,ng,ng}, EBSupport::full);
+        const Long ebdc_bytes = FabArrayBase::queryMemUsage("EBDataCollection");
+        const Long list_bytes = FabArrayBase::queryMemUsage("MultiCutCellList");
+
+        const EB2::Level& level = EB2::IndexSpace::top().getLevel(geom);
+        DenseData dense(level, geom, factory->getMultiEBCellFlagFab(), ng);
+        const Long dense_bytes = FabArrayBase::queryMemUsage("DenseEBData");
+
+        checkCutCells(*factory);
+        checkInterp(*factory, dense, geom);
+        checkAverageDown(*factory, dense, geom);
+
+        // The functions above must not have rebuilt the dense data.
+        AMREX_ALWAYS_ASSERT(FabArrayBase::queryMemUsage("EBDataCollection") == ebdc_bytes);
+
+        amrex::Print() << "Dense cell moments: " << dense_bytes << " bytes, "
+                       << "cut cell lists: " << list_bytes << " bytes\n";
+        AMREX_ALWAYS_ASSERT(list_bytes < dense_bytes);
+
+        checkRebuilt(*factory, dense);
+    }
+    amrex::Finalize();
+}
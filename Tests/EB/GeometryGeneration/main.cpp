@@ -0,0 +1,222 @@
+
+#include <AMReX.H>
+#include <AMReX_EB2.H>
+#include <AMReX_EB2_IF.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <vector>
+
+using namespace amrex;
+
+namespace {
+
+// Times the evaluation of f at all nodes of the domain point by point and in
+// batches, and the construction of the EB2 index space from f.
+template <class IF>
+void bench (const std::string& name, IF const& f, const Geometry& geom, int nrepeat)
+{
+    const Box nbx = amrex::surroundingNodes(geom.Domain());
+    const Real* problo = geom.ProbLo();
+    const Real* dx = geom.CellSize();
+    FArrayBox scalar_fab(nbx), batch_fab(nbx);
+    auto const& sa = scalar_fab.array();
+    auto const& ba = batch_fab.array();
+
+    Real t0 = amrex::second();
+    for (int irepeat = 0; irepeat < nrepeat; ++irepeat) {
+        amrex::LoopOnCpu(nbx, [&] (int i, int j, int k) noexcept
+        {
+            amrex::ignore_unused(j,k);
+            sa(i,j,k) = f(RealArray{AMREX_D_DECL(problo[0]+i*dx[0],
+                                                 problo[1]+j*dx[1],
+                                                 problo[2]+k*dx[2])});
+        });
+    }
+    const Real t_scalar = (amrex::second() - t0) / nrepeat;
+
+    t0 = amrex::second();
+    for (int irepeat = 0; irepeat < nrepeat; ++irepeat) {
+        const auto lo = amrex::lbound(nbx);
+        const auto hi = amrex::ubound(nbx);
+        AMREX_D_TERM(Real x[EB2::IFBatchSize];,
+                     Real y[EB2::IFBatchSize];,
+                     Real z[EB2::IFBatchSize];)
+        for         (int k = lo.z; k <= hi.z; ++k) {
+            for     (int j = lo.y; j <= hi.y; ++j) {
+                for (int i = lo.x; i <= hi.x; i += EB2::IFBatchSize) {
+                    const int n = std::min(EB2::IFBatchSize, hi.x-i+1);
+                    for (int m = 0; m < n; ++m) {
+                        AMREX_D_TERM(x[m] = problo[0]+(i+m)*dx[0];,
+                                     y[m] = problo[1]+j*dx[1];,
+                                     z[m] = problo[2]+k*dx[2];)
+                    }
+                    EB2::evalIFBatch(f, n, AMREX_D_DECL(x,y,z), ba.ptr(i,j,k));
+                }
+            }
+        }
+    }
+    const Real t_batch = (amrex::second() - t0) / nrepeat;
+
+    Real maxdiff = 0.0;
+    amrex::LoopOnCpu(nbx, [&] (int i, int j, int k) noexcept
+    {
+        maxdiff = std::max(maxdiff, std::abs(sa(i,j,k)-ba(i,j,k)));
+    });
+
+    // Batched evaluation must not change the values.
+    AMREX_ALWAYS_ASSERT(maxdiff == 0.0);
+
+    t0 = amrex::second();
+    EB2::Build(EB2::makeShop(f), geom, 0, 0);
+    const Real t_build = amrex::second() - t0;
+    EB2::IndexSpace::pop();
+
+    amrex::Print() << std::setw(12) << name
+                   << "  eval scalar " << std::setw(12) << t_scalar
+                   << "  eval batch " << std::setw(12) << t_batch
+                   << "  speedup " << std::setw(8) << t_scalar/t_batch
+                   << "  max diff " << std::setw(10) << maxdiff
+                   << "  EB2::Build " << std::setw(12) << t_build << "\n";
+}
+
+// The integer powers of the polynomial IF must agree with std::pow,
+// including negative powers.
+void checkPolynomialPowers ()
+{
+    const Real xs[] = {-1.7, -0.3, 0.25, 1.0, 2.5};
+    for (Real x : xs) {
+        for (int p = -5; p <= 5; ++p) {
+            const Real r = EB2::PIF_detail::ipow(x, p);
+            const Real e = std::pow(x, p);
+            AMREX_ALWAYS_ASSERT(std::abs(r-e) <= 1.e-14*std::abs(e));
+        }
+    }
+
+    Vector<EB2::PolyTerm> poly{{1.0, IntVect(AMREX_D_DECL(-2,1,0))},
+                               {-0.5, IntVect(AMREX_D_DECL(0,-1,3))}};
+    EB2::PolynomialIF f(poly, false);
+    const RealArray p{AMREX_D_DECL(0.7,-1.3,0.4)};
+    const Real e = -(std::pow(p[0],-2)*p[1] - 0.5*AMREX_D_PICK(1.0, 1.0/p[1], std::pow(p[2],3)/p[1]));
+    AMREX_ALWAYS_ASSERT(std::abs(f(p) - e) <= 1.e-14*std::abs(e));
+}
+
+EB2::SplineIF makePiston ()
+{
+    const Real s = 0.025;
+    std::vector<RealVect> splpts{
+        RealVect(AMREX_D_DECL(36.193*s,  7.8583*s, 0.0)),
+        RealVect(AMREX_D_DECL(35.924*s,  7.7881*s, 0.0)),
+        RealVect(AMREX_D_DECL(35.713*s,  7.5773*s, 0.0)),
+        RealVect(AMREX_D_DECL(35.643*s,  7.3083*s, 0.0)),
+        RealVect(AMREX_D_DECL(35.3  *s,  7.0281*s, 0.0)),
+        RealVect(AMREX_D_DECL(35.421*s,  6.241 *s, 0.0)),
+        RealVect(AMREX_D_DECL(34.82 *s,  5.686 *s, 0.0)),
+        RealVect(AMREX_D_DECL(30.539*s,  3.5043*s, 0.0)),
+        RealVect(AMREX_D_DECL(29.677*s,  2.6577*s, 0.0)),
+        RealVect(AMREX_D_DECL(29.457*s,  1.47  *s, 0.0)),
+        RealVect(AMREX_D_DECL(28.364*s, -5.7632*s, 0.0)),
+        RealVect(AMREX_D_DECL(27.151*s, -6.8407*s, 0.0)),
+        RealVect(AMREX_D_DECL(25.694*s, -7.5555*s, 0.0)),
+        RealVect(AMREX_D_DECL(24.035*s, -7.8586*s, 0.0)),
+        RealVect(AMREX_D_DECL(22.358*s, -7.6902*s, 0.0))};
+    EB2::SplineIF piston;
+    piston.addSplineElement(splpts);
+    piston.addLineElement({RealVect(AMREX_D_DECL(22.358*s, -7.6902*s, 0.0)),
+                           RealVect(AMREX_D_DECL(1.9934*s,  3.464 *s, 0.0)),
+                           RealVect(AMREX_D_DECL(0.0,       3.464 *s, 0.0))});
+    piston.addLineElement({RealVect(AMREX_D_DECL(49.0  *s, 7.8583*s, 0.0)),
+                           RealVect(AMREX_D_DECL(36.193*s, 7.8583*s, 0.0))});
+    return piston;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int n_cell = 128;
+        int max_grid_size = 32;
+        int nrepeat = 3;
+        std::string geom_type = "all";
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("nrepeat", nrepeat);
+            pp.query("geom_type", geom_type);
+        }
+        {
+            ParmParse pp("eb2");
+            pp.add("max_grid_size", max_grid_size);
+        }
+
+        const Box domain(IntVect(0), IntVect(n_cell-1));
+        RealBox rb({AMREX_D_DECL(-1.3,-1.3,-1.3)}, {AMREX_D_DECL(1.3,1.3,1.3)});
+        Geometry geom(domain, rb, 0, {AMREX_D_DECL(0,0,0)});
+
+        checkPolynomialPowers();
+
+        auto run = [&] (const std::string& name) { return geom_type == "all" || geom_type == name; };
+
+        if (run("spheres")) {
+            EB2::SphereIF s1(0.3, {AMREX_D_DECL( 0.3, 0.3, 0.3)}, false);
+            EB2::SphereIF s2(0.3, {AMREX_D_DECL(-0.3, 0.3, 0.3)}, false);
+            EB2::SphereIF s3(0.3, {AMREX_D_DECL( 0.3,-0.3, 0.3)}, false);
+            EB2::SphereIF s4(0.3, {AMREX_D_DECL( 0.3, 0.3,-0.3)}, false);
+            bench("spheres", EB2::makeUnion(s1,s2,s3,s4), geom, nrepeat);
+        }
+
+        if (run("csg")) {
+            EB2::SphereIF sphere(0.5, {AMREX_D_DECL(0.0,0.0,0.0)}, false);
+            EB2::BoxIF cube({AMREX_D_DECL(-0.4,-0.4,-0.4)}, {AMREX_D_DECL(0.4,0.4,0.4)}, false);
+            auto cubesphere = EB2::makeIntersection(sphere, cube);
+            EB2::CylinderIF cylinder_x(0.25, 0, {AMREX_D_DECL(0.0,0.0,0.0)}, false);
+            EB2::CylinderIF cylinder_y(0.25, 1, {AMREX_D_DECL(0.0,0.0,0.0)}, false);
+#if (AMREX_SPACEDIM == 3)
+            EB2::CylinderIF cylinder_z(0.25, 2, {AMREX_D_DECL(0.0,0.0,0.0)}, false);
+            auto cylinders = EB2::makeUnion(cylinder_x, cylinder_y, cylinder_z);
+#else
+            auto cylinders = EB2::makeUnion(cylinder_x, cylinder_y);
+#endif
+            bench("csg", EB2::makeDifference(cubesphere, cylinders), geom, nrepeat);
+        }
+
+        if (run("lathe")) {
+            auto polys = EB2::makeUnion(EB2::BoxIF({AMREX_D_DECL(0.2,-0.5,-1.)},
+                                                   {AMREX_D_DECL(0.4, 0.5, 1.)}, true),
+                                        EB2::PlaneIF({AMREX_D_DECL(0.8,0.,0.)},
+                                                     {AMREX_D_DECL(1.,0.2,0.)}));
+            bench("lathe", EB2::translate(EB2::lathe(polys), {AMREX_D_DECL(0.1,0.1,0.)}),
+                  geom, nrepeat);
+        }
+
+        if (run("polynomial")) {
+            Vector<EB2::PolyTerm> poly{
+                {1.0, IntVect(AMREX_D_DECL(2,0,0))},
+                {2.0, IntVect(AMREX_D_DECL(0,2,0))},
+#if (AMREX_SPACEDIM == 3)
+                {3.0, IntVect(AMREX_D_DECL(0,0,2))},
+                {0.5, IntVect(AMREX_D_DECL(1,1,1))},
+#endif
+                {0.1, IntVect(AMREX_D_DECL(3,1,0))},
+                {-0.4, IntVect(AMREX_D_DECL(0,0,0))}};
+            bench("polynomial", EB2::PolynomialIF(poly, false), geom, nrepeat);
+        }
+
+        if (run("spline")) {
+            // On finer grids, the piston has cells with more than two cuts
+            // on a face, which EB2 does not support.
+            const Box spline_domain(IntVect(0), IntVect(n_cell/2-1));
+            RealBox spline_rb({AMREX_D_DECL(-1.3,-1.3,-0.475)}, {AMREX_D_DECL(1.3,1.3,0.5)});
+            Geometry spline_geom(spline_domain, spline_rb, 0, {AMREX_D_DECL(0,0,0)});
+            EB2::CylinderIF cylinder(1.2, 1.75, AMREX_SPACEDIM-1,
+                                     {AMREX_D_DECL(0.0, 0.0, -0.25)}, true);
+            bench("spline", EB2::makeUnion(EB2::lathe(makePiston()), cylinder),
+                  spline_geom, nrepeat);
+        }
+    }
+    amrex::Finalize();
+}
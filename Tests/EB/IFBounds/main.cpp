@@ -0,0 +1,148 @@
+#include <AMReX.H>
+#include <AMReX_EB2.H>
+#include <AMReX_EB2_IF.H>
+#include <AMReX_EBFabFactory.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+namespace {
+
+// Hides the bounds of an implicit function, so that GeometryShop classifies
+// boxes by evaluating every node.
+template <class F>
+struct NoBoundsIF
+    : public GPUable
+{
+    F m_f;
+
+    explicit NoBoundsIF (F const& f) : m_f(f) {}
+
+    AMREX_GPU_HOST_DEVICE inline
+    Real operator() (AMREX_D_DECL(Real x, Real y, Real z)) const noexcept
+    {
+        return m_f(AMREX_D_DECL(x,y,z));
+    }
+
+    inline Real operator() (const RealArray& p) const noexcept
+    {
+        return m_f(p);
+    }
+};
+
+// Compares the classification of boxes with and without bounds pruning,
+// first on random boxes and then on the cell flags of the whole domain.
+template <class F>
+void compare (const std::string& name, F const& f, const Geometry& geom, int nboxes)
+{
+    static_assert(EB2::HasIFBounds<F>::value, "The test function must have bounds");
+    static_assert(!EB2::HasIFBounds<NoBoundsIF<F> >::value, "The wrapper must hide the bounds");
+
+    auto shop = EB2::makeShop(f);
+    auto shop_brute = EB2::makeShop(NoBoundsIF<F>(f));
+
+    const Box& domain = geom.Domain();
+    const int n = domain.length(0);
+    int nmixed = 0;
+    amrex::InitRandom(1);
+    for (int ib = 0; ib < nboxes; ++ib)
+    {
+        IntVect lo, hi;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            lo[idim] = amrex::Random_int(n);
+            hi[idim] = std::min(lo[idim] + static_cast<int>(amrex::Random_int(n/2)), n);
+        }
+        const Box bx(lo, hi, IndexType::TheNodeType());
+        const int t = shop.getBoxType(bx, geom, RunOn::Cpu);
+        AMREX_ALWAYS_ASSERT(t == shop_brute.getBoxType(bx, geom, RunOn::Cpu));
+        if (t == EB2::GeometryShop<F>::mixedcells) ++nmixed;
+    }
+
+    int max_grid_size = 16;
+    ParmParse pp;
+    pp.query("max_grid_size", max_grid_size);
+    BoxArray ba(domain);
+    ba.maxSize(max_grid_size);
+    DistributionMapping dm(ba);
+
+    EB2::Build(shop, geom, 0, 0);
+    auto factory = makeEBFabFactory(geom, ba, dm, {1,1,1}, EBSupport::volume);
+    EB2::Build(shop_brute, geom, 0, 0);
+    auto factory_brute = makeEBFabFactory(geom, ba, dm, {1,1,1}, EBSupport::volume);
+
+    const auto& flags = factory->getMultiEBCellFlagFab();
+    const auto& flags_brute = factory_brute->getMultiEBCellFlagFab();
+    const MultiFab& vfrac = factory->getVolFrac();
+    const MultiFab& vfrac_brute = factory_brute->getVolFrac();
+    Long ncut = 0;
+    for (MFIter mfi(vfrac); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.validbox();
+        AMREX_ALWAYS_ASSERT(flags[mfi].getType(bx) == flags_brute[mfi].getType(bx));
+        const auto& fl = flags.const_array(mfi);
+        const auto& flb = flags_brute.const_array(mfi);
+        const auto& vf = vfrac.const_array(mfi);
+        const auto& vfb = vfrac_brute.const_array(mfi);
+        amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+        {
+            AMREX_ALWAYS_ASSERT(fl(i,j,k) == flb(i,j,k));
+            AMREX_ALWAYS_ASSERT(vf(i,j,k) == vfb(i,j,k));
+            if (fl(i,j,k).isSingleValued()) ++ncut;
+        });
+    }
+    ParallelDescriptor::ReduceLongSum(ncut);
+
+    factory.reset();
+    factory_brute.reset();
+    EB2::IndexSpace::pop();
+    EB2::IndexSpace::pop();
+
+    amrex::Print() << name << ": " << nmixed << " of " << nboxes << " random boxes mixed, "
+                   << ncut << " cut cells, classification agrees\n";
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int n_cell = 64;
+        int nboxes = 2000;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("nboxes", nboxes);
+        }
+
+        const Box domain(IntVect(0), IntVect(n_cell-1));
+        RealBox rb({AMREX_D_DECL(-1.,-1.,-1.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Geometry geom(domain, rb, 0, {AMREX_D_DECL(0,0,0)});
+
+        {
+            EB2::SphereIF sphere(0.6, {AMREX_D_DECL(0.05,0.0,-0.05)}, false);
+            compare("sphere", sphere, geom, nboxes);
+        }
+
+        {
+            EB2::SphereIF s1(0.3, {AMREX_D_DECL( 0.3, 0.3, 0.3)}, false);
+            EB2::SphereIF s2(0.3, {AMREX_D_DECL(-0.3, 0.3, 0.3)}, false);
+            EB2::SphereIF s3(0.3, {AMREX_D_DECL( 0.3,-0.3, 0.3)}, false);
+            EB2::SphereIF s4(0.25, {AMREX_D_DECL( 0.3, 0.3,-0.3)}, true);
+            compare("union of spheres", EB2::makeUnion(s1,s2,s3,s4), geom, nboxes);
+        }
+
+        {
+            EB2::SphereIF sphere(0.5, {AMREX_D_DECL(0.0,0.0,0.0)}, false);
+            EB2::BoxIF cube({AMREX_D_DECL(-0.4,-0.4,-0.4)}, {AMREX_D_DECL(0.4,0.4,0.4)}, false);
+            auto cubesphere = EB2::makeIntersection(sphere, cube);
+            EB2::CylinderIF cylinder_x(0.25, 0, {AMREX_D_DECL(0.0,0.0,0.0)}, false);
+            EB2::CylinderIF cylinder_y(0.25, 1, {AMREX_D_DECL(0.0,0.0,0.0)}, false);
+            auto cylinders = EB2::makeUnion(cylinder_x, cylinder_y);
+            compare("csg", EB2::translate(EB2::makeDifference(cubesphere, cylinders),
+                                          {AMREX_D_DECL(0.1,-0.05,0.02)}), geom, nboxes);
+        }
+    }
+    amrex::Finalize();
+}
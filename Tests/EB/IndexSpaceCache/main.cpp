@@ -0,0 +1,180 @@
+#include <AMReX.H>
+#include <AMReX_EB2.H>
+#include <AMReX_EB2_IF.H>
+#include <AMReX_EBFabFactory.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_Utility.H>
+
+using namespace amrex;
+
+namespace {
+
+void compareFab (const FArrayBox& a, const FArrayBox& b)
+{
+    AMREX_ALWAYS_ASSERT(a.box() == b.box() && a.nComp() == b.nComp());
+    const auto& aa = a.const_array();
+    const auto& ba = b.const_array();
+    amrex::LoopOnCpu(a.box(), a.nComp(), [&] (int i, int j, int k, int n) noexcept
+    {
+        AMREX_ALWAYS_ASSERT(aa(i,j,k,n) == ba(i,j,k,n));
+    });
+}
+
+void compareCutFab (const MultiCutFab& a, const MultiCutFab& b, const MFIter& mfi)
+{
+    AMREX_ALWAYS_ASSERT(a.ok(mfi) == b.ok(mfi));
+    if (a.ok(mfi)) compareFab(a[mfi], b[mfi]);
+}
+
+// Compares all EB data of two factories on the same grids.
+void compareFactories (const EBFArrayBoxFactory& a, const EBFArrayBoxFactory& b)
+{
+    const auto& flags_a = a.getMultiEBCellFlagFab();
+    const auto& flags_b = b.getMultiEBCellFlagFab();
+    for (MFIter mfi(a.getVolFrac()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = flags_a[mfi].box();
+        AMREX_ALWAYS_ASSERT(bx == flags_b[mfi].box());
+        AMREX_ALWAYS_ASSERT(flags_a[mfi].getType(bx) == flags_b[mfi].getType(bx));
+        const auto& fa = flags_a.const_array(mfi);
+        const auto& fb = flags_b.const_array(mfi);
+        amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+        {
+            AMREX_ALWAYS_ASSERT(fa(i,j,k) == fb(i,j,k));
+        });
+
+        compareFab(a.getVolFrac()[mfi], b.getVolFrac()[mfi]);
+        compareCutFab(a.getCentroid(), b.getCentroid(), mfi);
+        compareCutFab(a.getBndryCent(), b.getBndryCent(), mfi);
+        compareCutFab(a.getBndryNormal(), b.getBndryNormal(), mfi);
+        compareCutFab(a.getBndryArea(), b.getBndryArea(), mfi);
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            compareCutFab(*a.getAreaFrac()[idim], *b.getAreaFrac()[idim], mfi);
+            compareCutFab(*a.getFaceCent()[idim], *b.getFaceCent()[idim], mfi);
+        }
+    }
+}
+
+bool cacheExists (const std::string& description)
+{
+    int exist = 0;
+    if (ParallelDescriptor::IOProcessor()) {
+        exist = amrex::FileExists(EB2::CachePath(description) + "/Header");
+    }
+    ParallelDescriptor::Bcast(&exist, 1, ParallelDescriptor::IOProcessorNumber());
+    return exist;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int n_cell = 64;
+        int max_grid_size = 16;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+        AMREX_ALWAYS_ASSERT(!EB2::CacheDir().empty());
+
+        if (ParallelDescriptor::IOProcessor() && amrex::FileExists(EB2::CacheDir())) {
+            amrex::FileSystem::RemoveAll(EB2::CacheDir());
+        }
+        ParallelDescriptor::Barrier();
+
+        const Box domain(IntVect(0), IntVect(n_cell-1));
+        RealBox rb({AMREX_D_DECL(-1.,-1.,-1.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Geometry geom(domain, rb, 0, {AMREX_D_DECL(0,0,0)});
+        const Geometry cgeom = amrex::coarsen(geom, 2);
+
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+        const BoxArray cba = amrex::coarsen(ba, 2);
+
+        const int max_coarsening_level = 2;
+        const std::string key = "sphere";
+        EB2::SphereIF sphere(0.6, {AMREX_D_DECL(0.05,0.0,-0.05)}, false);
+        // A different shape stored under the same key.  Reading it back
+        // must give the sphere.
+        EB2::SphereIF impostor(0.3, {AMREX_D_DECL(0.0,0.0,0.0)}, true);
+
+        auto make_factories = [&] ()
+        {
+            return std::make_pair(makeEBFabFactory(geom, ba, dm, {2,2,2}, EBSupport::full),
+                                  makeEBFabFactory(cgeom, cba, dm, {2,2,2}, EBSupport::full));
+        };
+
+        // Without a key, nothing is cached.
+        EB2::Build(EB2::makeShop(sphere), geom, 0, max_coarsening_level, 4, true,
+                   EB2::ExtendDomainFace(), "");
+        auto fresh = make_factories();
+        const std::string description
+            = EB2::CacheDescription(key, geom, 0, max_coarsening_level, 4, true,
+                                    EB2::ExtendDomainFace());
+        AMREX_ALWAYS_ASSERT(!cacheExists(description));
+
+        // Build and write the cache.
+        EB2::Build(EB2::makeShop(sphere), geom, 0, max_coarsening_level, 4, true,
+                   EB2::ExtendDomainFace(), key);
+        AMREX_ALWAYS_ASSERT(cacheExists(description));
+        {
+            auto written = make_factories();
+            compareFactories(*fresh.first, *written.first);
+            compareFactories(*fresh.second, *written.second);
+        }
+        EB2::IndexSpace::pop();
+
+        // Read the cache.
+        EB2::Build(EB2::makeShop(impostor), geom, 0, max_coarsening_level, 4, true,
+                   EB2::ExtendDomainFace(), key);
+        {
+            auto cached = make_factories();
+            compareFactories(*fresh.first, *cached.first);
+            compareFactories(*fresh.second, *cached.second);
+        }
+        EB2::IndexSpace::pop();
+        amrex::Print() << "Index space read from the cache matches the generated one\n";
+
+        // Anything that changes the index space gives a different key.
+        const std::string path = EB2::CachePath(description);
+        const std::string other[] = {
+            EB2::CacheDescription("sphere2", geom, 0, max_coarsening_level, 4, true,
+                                  EB2::ExtendDomainFace()),
+            EB2::CacheDescription(key, cgeom, 0, max_coarsening_level, 4, true,
+                                  EB2::ExtendDomainFace()),
+            EB2::CacheDescription(key, geom, 0, max_coarsening_level-1, 4, true,
+                                  EB2::ExtendDomainFace()),
+            EB2::CacheDescription(key, geom, 0, max_coarsening_level, 2, true,
+                                  EB2::ExtendDomainFace()),
+            EB2::CacheDescription(key, geom, 0, max_coarsening_level, 4, false,
+                                  EB2::ExtendDomainFace()),
+            EB2::CacheDescription(key, geom, 0, max_coarsening_level, 4, true,
+                                  !EB2::ExtendDomainFace())};
+        for (const auto& d : other) {
+            AMREX_ALWAYS_ASSERT(d != description && EB2::CachePath(d) != path);
+        }
+
+        // A changed parameter does not pick up the old cache.
+        EB2::Build(EB2::makeShop(impostor), geom, 0, max_coarsening_level-1, 4, true,
+                   EB2::ExtendDomainFace(), key);
+        {
+            auto rebuilt = makeEBFabFactory(geom, ba, dm, {2,2,2}, EBSupport::full);
+            const Real v_fresh = fresh.first->getVolFrac().sum();
+            const Real v_rebuilt = rebuilt->getVolFrac().sum();
+            AMREX_ALWAYS_ASSERT(std::abs(v_fresh - v_rebuilt) > 1.0);
+        }
+        AMREX_ALWAYS_ASSERT(cacheExists(other[2]));
+        EB2::IndexSpace::pop();
+        amrex::Print() << "Changed parameters give a different cache\n";
+
+        fresh.first.reset();
+        fresh.second.reset();
+        EB2::IndexSpace::pop();
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,109 @@
+
+#include <AMReX.H>
+#include <AMReX_Print.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Utility.H>
+
+using namespace amrex;
+
+void test ();
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    test();
+    amrex::Finalize();
+}
+
+// Times chains of MultiFab arithmetic done one operation at a time and as
+// fused expressions, and checks that they agree.  The expressions are
+// written in the order of the separate operations, so the results must be
+// identical.
+void test ()
+{
+    int n_cell = 128;
+    int max_grid_size = 32;
+    int ncomp = 2;
+    int nrepeat = 10;
+    {
+        ParmParse pp;
+        pp.query("n_cell", n_cell);
+        pp.query("max_grid_size", max_grid_size);
+        pp.query("ncomp", ncomp);
+        pp.query("nrepeat", nrepeat);
+    }
+
+    BoxArray ba(Box(IntVect(0), IntVect(n_cell-1)));
+    ba.maxSize(max_grid_size);
+    DistributionMapping dm(ba);
+
+    MultiFab x(ba, dm, ncomp, 0);
+    MultiFab y(ba, dm, ncomp, 0);
+    MultiFab z(ba, dm, ncomp, 0);
+    MultiFab d1(ba, dm, ncomp, 0);
+    MultiFab d2(ba, dm, ncomp, 0);
+
+    for (MFIter mfi(x); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.validbox();
+        auto const& xa = x.array(mfi);
+        auto const& ya = y.array(mfi);
+        auto const& za = z.array(mfi);
+        amrex::ParallelFor(bx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            xa(i,j,k,n) = std::sin(0.1*i+0.2*j+0.3*k+n);
+            ya(i,j,k,n) = std::cos(0.3*i+0.1*j+0.2*k-n);
+            za(i,j,k,n) = 1.0 + 0.5*std::sin(0.2*i+0.3*j+0.1*k);
+        });
+    }
+
+    const Real a = 0.7;
+    const Real b = -1.3;
+
+    // d = y*z*b + a*x
+    Real t0 = amrex::second();
+    for (int irepeat = 0; irepeat < nrepeat; ++irepeat) {
+        MultiFab::Copy(d1, y, 0, 0, ncomp, 0);
+        MultiFab::Multiply(d1, z, 0, 0, ncomp, 0);
+        d1.mult(b, 0, ncomp);
+        MultiFab::Saxpy(d1, a, x, 0, 0, ncomp, 0);
+    }
+    Real t_sep = (amrex::second() - t0) / nrepeat;
+
+    t0 = amrex::second();
+    for (int irepeat = 0; irepeat < nrepeat; ++irepeat) {
+        d2 = y*z*b + a*x;
+    }
+    Real t_fused = (amrex::second() - t0) / nrepeat;
+
+    Real maxdiff = amrex::Max(amrex::abs(d2-d1), ncomp);
+    amrex::Print() << "d = y*z*b + a*x:  separate " << t_sep << " s, fused " << t_fused
+                   << " s, max diff " << maxdiff << "\n";
+    AMREX_ALWAYS_ASSERT(maxdiff == 0.0);
+
+    // d = d - a*x; dd = dot(d,d), as in a CG iteration.
+    MultiFab::Copy(d2, d1, 0, 0, ncomp, 0);
+    Real dd1 = 0.0;
+    t0 = amrex::second();
+    for (int irepeat = 0; irepeat < nrepeat; ++irepeat) {
+        MultiFab::Saxpy(d1, -a, x, 0, 0, ncomp, 0);
+        dd1 = MultiFab::Dot(d1, 0, d1, 0, ncomp, 0);
+    }
+    t_sep = (amrex::second() - t0) / nrepeat;
+
+    Real dd2 = 0.0;
+    t0 = amrex::second();
+    for (int irepeat = 0; irepeat < nrepeat; ++irepeat) {
+        dd2 = amrex::AssignAndSum(d2, d2 - a*x, d2*d2);
+    }
+    t_fused = (amrex::second() - t0) / nrepeat;
+
+    maxdiff = amrex::Max(amrex::abs(d2-d1), ncomp);
+    const Real dotdiff = std::abs(dd1-dd2)/std::abs(dd1);
+    amrex::Print() << "d -= a*x, dot(d,d):  separate " << t_sep << " s, fused " << t_fused
+                   << " s, max diff " << maxdiff << ", dot diff " << dotdiff << "\n";
+    AMREX_ALWAYS_ASSERT(maxdiff == 0.0);
+    // The partial sums of threads and GPU blocks may be added in a
+    // different order.
+    AMREX_ALWAYS_ASSERT(dotdiff < 1.e-12);
+}
@@ -23,11 +23,13 @@ main (int argc, char* argv[])
     std::string ba_file("ba.max");
     int max_grid_size = 32;
     int min_ba_size = 12800;
+    int coarsen = 1;
     {
 	ParmParse pp;
 	pp.query("ba_file", ba_file);
 	pp.query("max_grid_size", max_grid_size);
 	pp.query("min_ba_size", min_ba_size);
+	pp.query("coarsen", coarsen);
     }
 
     int nAtOnce = std::min(ParallelDescriptor::NProcs(), 32);
@@ -66,6 +68,10 @@ main (int argc, char* argv[])
 	}
     }
 
+    if (coarsen > 1) {
+	ba.coarsen(coarsen);
+    }
+
     while (ba.size() < min_ba_size) {
 	ba.refine(2);
 	ba.maxSize(max_grid_size);
@@ -162,6 +168,81 @@ main (int argc, char* argv[])
 	std::cout << "ignore this line " << err << std::endl;
     }
 
+    //
+    // FillBoundary of several MultiFabs with different numbers of components
+    // and ghost cells, one at a time and fused into one message per
+    // neighbor.  Use the coarsest BoxArray so that the messages are small.
+    //
+    {
+	int nmfs = 8;
+	{
+	    ParmParse pp;
+	    pp.query("nmfs", nmfs);
+	}
+
+	const BoxArray& cba = bas[nlevels-1];
+	Vector<std::unique_ptr<MultiFab> > sep(nmfs), fused(nmfs);
+	for (int i = 0; i < nmfs; ++i) {
+	    const int ncomp = 1 + i%3;
+	    const int ngrow = 1 + i%2;
+	    sep[i].reset(new MultiFab(cba, dm, ncomp, ngrow));
+	    fused[i].reset(new MultiFab(cba, dm, ncomp, ngrow));
+	    sep[i]->setVal(0.0);
+	    fused[i]->setVal(0.0);
+	    for (MFIter mfi(*sep[i]); mfi.isValid(); ++mfi) {
+		const Box& bx = mfi.validbox();
+		auto const& a = sep[i]->array(mfi);
+		auto const& b = fused[i]->array(mfi);
+		amrex::ParallelFor(bx, ncomp, [=] AMREX_GPU_DEVICE (int ii, int jj, int kk, int n) noexcept
+		{
+		    a(ii,jj,kk,n) = b(ii,jj,kk,n) = ii + 1000.*jj + 1.e6*kk + 0.1*n + i;
+		});
+	    }
+	}
+
+	FabArrayCommGroup<FArrayBox> fbg;
+	for (int i = 0; i < nmfs; ++i) {
+	    fbg.addFillBoundary(*fused[i]);
+	}
+
+	ParallelDescriptor::Barrier();
+	auto t0 = ParallelDescriptor::second();
+	for (int iround = 0; iround < nrounds; ++iround) {
+	    for (int i = 0; i < nmfs; ++i) {
+		sep[i]->FillBoundary();
+	    }
+	}
+	ParallelDescriptor::Barrier();
+	auto t1 = ParallelDescriptor::second();
+	for (int iround = 0; iround < nrounds; ++iround) {
+	    fbg.FillBoundary_nowait();
+	    fbg.FillBoundary_finish();
+	}
+	ParallelDescriptor::Barrier();
+	auto t2 = ParallelDescriptor::second();
+
+	// The group must lay out its messages again for the rebuilt FB
+	// metadata, even if they happen to get the old addresses.
+	FabArrayBase::flushFBCache();
+	fbg.FillBoundary();
+
+	Real maxdiff = 0.0;
+	for (int i = 0; i < nmfs; ++i) {
+	    MultiFab::Subtract(*fused[i], *sep[i], 0, 0, sep[i]->nComp(), sep[i]->nGrow());
+	    maxdiff = std::max(maxdiff, fused[i]->norm0(0, sep[i]->nGrow()));
+	}
+
+	if (ParallelDescriptor::IOProcessor()) {
+	    std::cout << "FillBoundary of " << nmfs << " MultiFabs with " << cba.size()
+		      << " boxes" << std::endl;
+	    std::cout << "  one at a time: " << t1-t0 << std::endl;
+	    std::cout << "  fused        : " << t2-t1 << std::endl;
+	    std::cout << "  max diff     : " << maxdiff << std::endl;
+	}
+
+	AMREX_ALWAYS_ASSERT(maxdiff == 0.0);
+    }
+
     //
     // When MPI3 shared memory is used, the dtor of MultiFab calls MPI
     // functions.  Because the scope of mfs is beyond the call to
@@ -0,0 +1,146 @@
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_PhysBCFunct.H>
+#include <AMReX_FillPatchUtil.H>
+
+using namespace amrex;
+
+// Compare FillPatchSingleLevel and FabArray::ParallelCopyLinComb with
+// interpolating in time on the source BoxArray followed by ParallelCopy.
+
+void initData (const Geometry& geom, MultiFab& mf, Real shift)
+{
+    const auto plo = geom.ProbLoArray();
+    const auto dx  = geom.CellSizeArray();
+    const int ncomp = mf.nComp();
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        const auto& a = mf.array(mfi);
+        amrex::ParallelFor(bx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            int iv[3] = {i, j, k};
+            Real f = 1.0 + n + shift;
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                const Real x = plo[d] + (iv[d]+0.5)*dx[d];
+                f += std::sin(2.0*M_PI*(d+1)*(x+shift));
+            }
+            a(i,j,k,n) = f;
+        });
+    }
+}
+
+Real maxDiff (const MultiFab& a, const MultiFab& b, int ncomp, int nghost)
+{
+    MultiFab diff(a.boxArray(), a.DistributionMap(), ncomp, nghost);
+    MultiFab::Copy(diff, a, 0, 0, ncomp, nghost);
+    MultiFab::Subtract(diff, b, 0, 0, ncomp, nghost);
+    Real r = 0.0;
+    for (int n = 0; n < ncomp; ++n) {
+        r = std::max(r, diff.norm0(n, nghost));
+    }
+    return r;
+}
+
+// The result of the old FillPatchSingleLevel: interpolate in time on all
+// of the source data, then ParallelCopy.
+void fillReference (MultiFab& dst, const MultiFab& s0, const MultiFab& s1,
+                    Real t0, Real t1, Real time, int scomp, int ncomp,
+                    const Geometry& geom)
+{
+    MultiFab tmp(s0.boxArray(), s0.DistributionMap(), ncomp, 0);
+    if (time == t0) {
+        MultiFab::Copy(tmp, s0, scomp, 0, ncomp, 0);
+    } else if (time == t1) {
+        MultiFab::Copy(tmp, s1, scomp, 0, ncomp, 0);
+    } else if (! amrex::almostEqual(t0,t1)) {
+        Real alpha = (t1-time)/(t1-t0);
+        Real beta = (time-t0)/(t1-t0);
+        MultiFab::LinComb(tmp, alpha, s0, scomp, beta, s1, scomp, 0, ncomp, 0);
+    } else {
+        MultiFab::Copy(tmp, s0, scomp, 0, ncomp, 0);
+    }
+    dst.setVal(-1.0);
+    dst.ParallelCopy(tmp, 0, 0, ncomp, IntVect(0), dst.nGrowVect(), geom.periodicity());
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int n_cell = 64;
+        int src_max_grid_size = 16;
+        int dst_max_grid_size = 24;
+        int nghost = 2;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("src_max_grid_size", src_max_grid_size);
+            pp.query("dst_max_grid_size", dst_max_grid_size);
+            pp.query("nghost", nghost);
+        }
+
+        Box domain(IntVect(0), IntVect(n_cell-1));
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,1,1)};
+        Geometry geom(domain, rb, CoordSys::cartesian, is_periodic);
+
+        const int ncomp = 2;
+
+        BoxArray sba(domain);
+        sba.maxSize(src_max_grid_size);
+        DistributionMapping sdm(sba);
+
+        BoxArray dba(domain);
+        dba.maxSize(dst_max_grid_size);
+        DistributionMapping ddm(dba);
+        AMREX_ALWAYS_ASSERT(dba != sba);
+
+        MultiFab s0(sba, sdm, ncomp, 0);
+        MultiFab s1(sba, sdm, ncomp, 0);
+        initData(geom, s0, 0.0);
+        initData(geom, s1, 0.3);
+
+        MultiFab dst(dba, ddm, ncomp, nghost);
+        MultiFab ref(dba, ddm, ncomp, nghost);
+
+        PhysBCFunctNoOp physbc;
+
+        struct TimeCase { Real t0, t1, time; const char* name; };
+        const TimeCase cases[] = { {0.0, 1.0, 0.25, "t0 < time < t1"},
+                                   {0.0, 1.0, 0.0,  "time == t0"},
+                                   {0.0, 1.0, 1.0,  "time == t1"},
+                                   {0.5, 0.5, 0.5,  "t0 == t1 == time"} };
+
+        for (const auto& c : cases)
+        {
+            fillReference(ref, s0, s1, c.t0, c.t1, c.time, 0, ncomp, geom);
+
+            dst.setVal(-1.0);
+            FillPatchSingleLevel(dst, IntVect(nghost), c.time, {&s0, &s1}, {c.t0, c.t1},
+                                 0, 0, ncomp, geom, physbc, 0);
+            const Real e = maxDiff(dst, ref, ncomp, nghost);
+            amrex::Print() << "FillPatchSingleLevel, " << c.name << ": max diff = " << e << "\n";
+            AMREX_ALWAYS_ASSERT(e < 1.e-14);
+        }
+
+        // ParallelCopyLinComb on a subset of the components.
+        {
+            const Real a = 0.375;
+            const Real b = 0.625;
+            MultiFab tmp(sba, sdm, 1, 0);
+            MultiFab::LinComb(tmp, a, s0, 1, b, s1, 1, 0, 1, 0);
+            ref.setVal(-1.0);
+            ref.ParallelCopy(tmp, 0, 1, 1, IntVect(0), IntVect(nghost), geom.periodicity());
+
+            dst.setVal(-1.0);
+            dst.ParallelCopyLinComb(a, s0, b, s1, 1, 1, 1, IntVect(0), IntVect(nghost),
+                                    geom.periodicity());
+            const Real e = maxDiff(dst, ref, ncomp, nghost);
+            amrex::Print() << "ParallelCopyLinComb, component 1: max diff = " << e << "\n";
+            AMREX_ALWAYS_ASSERT(e < 1.e-14);
+        }
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,215 @@
+
+#include <AMReX.H>
+#include <AMReX_Print.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_FluxRegister.H>
+#include <AMReX_Utility.H>
+
+using namespace amrex;
+
+void test ();
+void fill (MultiFab& mf, Real a);
+void check_copy (const BoxArray& fba, const DistributionMapping& fdm, const IntVect& ratio,
+                 const Array<MultiFab,AMREX_SPACEDIM>& cflux, int ncomp);
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    test();
+    amrex::Finalize();
+}
+
+// Fills mf with smooth data that do not depend on the decomposition.
+void fill (MultiFab& mf, Real a)
+{
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(mf,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.tilebox();
+        auto const& f = mf.array(mfi);
+        amrex::ParallelFor(bx, mf.nComp(), [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            f(i,j,k,n) = std::sin(a*(i+1) + 0.37*j - 0.11*k + 0.5*n);
+        });
+    }
+}
+
+// Times the flux register operations of a coarse step done one direction
+// (CrseInit, FineAdd) and one face (Reflux) at a time, against the versions
+// that do all faces at once, and checks that the results agree.
+void test ()
+{
+    int n_cell = 128;
+    int max_grid_size = 32;
+    int fine_grid_size = 16;
+    int ncomp = 4;
+    int nrepeat = 5;
+    int periodic = 1;
+    {
+        ParmParse pp;
+        pp.query("n_cell", n_cell);
+        pp.query("max_grid_size", max_grid_size);
+        pp.query("fine_grid_size", fine_grid_size);
+        pp.query("ncomp", ncomp);
+        pp.query("nrepeat", nrepeat);
+        pp.query("periodic", periodic);
+    }
+
+    const IntVect ratio(2);
+    const Box domain(IntVect(0), IntVect(n_cell-1));
+    RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(periodic,periodic,periodic)};
+    Geometry geom(domain, rb, CoordSys::cartesian, is_periodic);
+
+    BoxArray cba(domain);
+    cba.maxSize(max_grid_size);
+    DistributionMapping cdm(cba);
+
+    // The fine level covers every other coarse box, and some of its boxes
+    // touch the periodic boundary.
+    BoxList fbl;
+    for (int i = 0; i < cba.size(); i += 2) {
+        fbl.push_back(amrex::refine(cba[i], ratio));
+    }
+    BoxArray fba(std::move(fbl));
+    fba.maxSize(fine_grid_size);
+    DistributionMapping fdm(fba);
+
+    Array<MultiFab,AMREX_SPACEDIM> cflux, fflux;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        const IntVect typ = IntVect::TheDimensionVector(idim);
+        cflux[idim].define(amrex::convert(cba,typ), cdm, ncomp, 0);
+        fflux[idim].define(amrex::convert(fba,typ), fdm, ncomp, 0);
+        fill(cflux[idim], 0.3+idim);
+        fill(fflux[idim], 0.7+idim);
+    }
+    check_copy(fba, fdm, ratio, cflux, ncomp);
+
+    const auto cflux_p = GetArrOfConstPtrs(cflux);
+    const auto fflux_p = GetArrOfConstPtrs(fflux);
+
+    MultiFab S0(cba, cdm, ncomp, 0);
+    fill(S0, 0.1);
+    MultiFab S_face(cba, cdm, ncomp, 0);
+    MultiFab S_fused(cba, cdm, ncomp, 0);
+    MultiFab::Copy(S_face, S0, 0, 0, ncomp, 0);
+    MultiFab::Copy(S_fused, S0, 0, 0, ncomp, 0);
+
+    MultiFab volume(cba, cdm, 1, 0);
+    volume.setVal(AMREX_D_TERM(geom.CellSize(0),*geom.CellSize(1),*geom.CellSize(2)));
+
+    FluxRegister fr_face(fba, fdm, ratio, 1, ncomp);
+    FluxRegister fr_fused(fba, fdm, ratio, 1, ncomp);
+
+    Real t_face_reg = 0., t_face_reflux = 0., t_fused_reg = 0., t_fused_reflux = 0.;
+    for (int irepeat = 0; irepeat < nrepeat; ++irepeat)
+    {
+        ParallelDescriptor::Barrier();
+        Real t0 = amrex::second();
+        fr_face.setVal(0.0);
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            fr_face.CrseInit(cflux[idim], idim, 0, 0, ncomp, -1.0, FluxRegister::ADD);
+        }
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            fr_face.FineAdd(fflux[idim], idim, 0, 0, ncomp, 0.25);
+        }
+        ParallelDescriptor::Barrier();
+        Real t1 = amrex::second();
+        for (OrientationIter fi; fi; ++fi) {
+            fr_face.Reflux(S_face, volume, fi(), 1.0, 0, 0, ncomp, geom);
+        }
+        ParallelDescriptor::Barrier();
+        Real t2 = amrex::second();
+        t_face_reg += t1-t0;
+        t_face_reflux += t2-t1;
+
+        t0 = amrex::second();
+        fr_fused.setVal(0.0);
+        fr_fused.CrseInit(cflux_p, 0, 0, ncomp, -1.0, FluxRegister::ADD);
+        fr_fused.FineAdd(fflux_p, 0, 0, ncomp, 0.25);
+        ParallelDescriptor::Barrier();
+        t1 = amrex::second();
+        fr_fused.Reflux(S_fused, volume, 1.0, 0, 0, ncomp, geom);
+        ParallelDescriptor::Barrier();
+        t2 = amrex::second();
+        t_fused_reg += t1-t0;
+        t_fused_reflux += t2-t1;
+    }
+
+    MultiFab::Subtract(S0, S_face, 0, 0, ncomp, 0);
+    const Real change = S0.norm0(0, 0);
+    MultiFab::Subtract(S_fused, S_face, 0, 0, ncomp, 0);
+    Real diff = 0.;
+    for (int n = 0; n < ncomp; ++n) {
+        diff = std::max(diff, S_fused.norm0(n, 0));
+    }
+
+    amrex::Print() << cba.size() << " coarse and " << fba.size() << " fine boxes, "
+                   << ncomp << " components\n"
+                   << "    one direction or face at a time: registers " << t_face_reg/nrepeat
+                   << " s, reflux " << t_face_reflux/nrepeat << " s\n"
+                   << "    all faces at once:               registers " << t_fused_reg/nrepeat
+                   << " s, reflux " << t_fused_reflux/nrepeat << " s\n"
+                   << "    max change by reflux " << change
+                   << ", max difference " << diff << "\n";
+}
+
+// CrseInit with COPY must overwrite the registers only where there are
+// fluxes, as FabSet::copyFrom does.  The fluxes here cover a third of the
+// coarse boxes.
+void check_copy (const BoxArray& fba, const DistributionMapping& fdm, const IntVect& ratio,
+                 const Array<MultiFab,AMREX_SPACEDIM>& cflux, int ncomp)
+{
+    const Real old_value = 7.0;
+    const Real mult = -2.0;
+    FluxRegister fr(fba, fdm, ratio, 1, ncomp);
+    FluxRegister fr_ref(fba, fdm, ratio, 1, ncomp);
+    fr.setVal(old_value);
+    fr_ref.setVal(old_value);
+
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+    {
+        const BoxArray& ba = cflux[idim].boxArray();
+        BoxList bl(ba.ixType());
+        for (int i = 0; i < ba.size(); i += 3) {
+            bl.push_back(ba[i]);
+        }
+        BoxArray pba(std::move(bl));
+        DistributionMapping pdm(pba);
+        MultiFab part(pba, pdm, ncomp, 0);
+        part.ParallelCopy(cflux[idim]);
+
+        fr.CrseInit(part, idim, 0, 0, ncomp, mult, FluxRegister::COPY);
+
+        part.mult(mult);
+        fr_ref[Orientation(idim,Orientation::low)].copyFrom(part, 0, 0, 0, ncomp);
+        fr_ref[Orientation(idim,Orientation::high)].copyFrom(part, 0, 0, 0, ncomp);
+    }
+
+    Long nold = 0, nnew = 0;
+    for (OrientationIter fi; fi; ++fi)
+    {
+        const Orientation face = fi();
+        for (FabSetIter mfi(fr[face]); mfi.isValid(); ++mfi)
+        {
+            const auto& a = fr[face].const_array(mfi);
+            const auto& b = fr_ref[face].const_array(mfi);
+            amrex::LoopOnCpu(mfi.validbox(), ncomp, [&] (int i, int j, int k, int n) noexcept
+            {
+                AMREX_ALWAYS_ASSERT(a(i,j,k,n) == b(i,j,k,n));
+                if (a(i,j,k,n) == old_value) {
+                    ++nold;
+                } else {
+                    ++nnew;
+                }
+            });
+        }
+    }
+    ParallelDescriptor::ReduceLongSum(nold);
+    ParallelDescriptor::ReduceLongSum(nnew);
+    AMREX_ALWAYS_ASSERT(nold > 0 && nnew > 0);
+    amrex::Print() << "CrseInit with COPY matches copyFrom: " << nnew << " values copied, "
+                   << nold << " left alone\n";
+}
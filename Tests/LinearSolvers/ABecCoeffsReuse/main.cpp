@@ -0,0 +1,161 @@
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_MLABecLaplacian.H>
+#include <AMReX_MLMG.H>
+
+using namespace amrex;
+
+struct TestParams {
+    int n_cell;
+    int max_grid_size;
+    Real reuse_rtol;
+};
+
+void setCoeffs (const Geometry& geom, MultiFab& alpha, Array<MultiFab,AMREX_SPACEDIM>& beta,
+                Real a, Real eps)
+{
+    // b = 1 + 0.5*sin(2 pi x) sin(2 pi y) sin(2 pi z), perturbed by eps.
+    const auto plo = geom.ProbLoArray();
+    const auto dx  = geom.CellSizeArray();
+    alpha.setVal(a);
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+    {
+        for (MFIter mfi(beta[idim]); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            const auto& b = beta[idim].array(mfi);
+            const IntVect nodal = beta[idim].ixType().toIntVect();
+            amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                Real f = 1.0;
+                int iv[3] = {i, j, k};
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    const Real x = plo[d] + (iv[d] + (nodal[d] ? 0.0 : 0.5))*dx[d];
+                    f *= std::sin(2.0*M_PI*x);
+                }
+                b(i,j,k) = (1.0 + eps) + 0.5*(1.0 - eps)*f;
+            });
+        }
+    }
+}
+
+void setRhs (const Geometry& geom, MultiFab& rhs)
+{
+    // A zero-mean right hand side, so that the singular problem is solvable.
+    const auto plo = geom.ProbLoArray();
+    const auto dx  = geom.CellSizeArray();
+    for (MFIter mfi(rhs); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        const auto& r = rhs.array(mfi);
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            int iv[3] = {i, j, k};
+            Real f = 1.0;
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                f *= std::cos(2.0*M_PI*(plo[d] + (iv[d]+0.5)*dx[d]));
+            }
+            r(i,j,k) = f;
+        });
+    }
+}
+
+void solve (MLMG& mlmg, MultiFab& soln, const MultiFab& rhs)
+{
+    soln.setVal(0.0);
+    mlmg.solve({&soln}, {&rhs}, 1.e-11, 0.0);
+}
+
+Real maxDiff (const MultiFab& a, const MultiFab& b, bool subtract_mean)
+{
+    MultiFab diff(a.boxArray(), a.DistributionMap(), 1, 0);
+    MultiFab::Copy(diff, a, 0, 0, 1, 0);
+    MultiFab::Subtract(diff, b, 0, 0, 1, 0);
+    if (subtract_mean) {
+        const Real mean = diff.sum() / diff.boxArray().numPts();
+        diff.plus(-mean, 0, 1, 0);
+    }
+    return diff.norm0() / b.norm0();
+}
+
+void testReuse (const TestParams& parms, bool singular)
+{
+    Box domain(IntVect(0), IntVect(parms.n_cell-1));
+    RealBox real_box({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(0,0,0)};
+    Geometry geom(domain, real_box, CoordSys::cartesian, is_periodic);
+
+    BoxArray ba(domain);
+    ba.maxSize(parms.max_grid_size);
+    DistributionMapping dm(ba);
+
+    MultiFab alpha(ba, dm, 1, 0);
+    Array<MultiFab,AMREX_SPACEDIM> beta;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        beta[idim].define(amrex::convert(ba, IntVect::TheDimensionVector(idim)), dm, 1, 0);
+    }
+    MultiFab rhs(ba, dm, 1, 0);
+    setRhs(geom, rhs);
+    MultiFab soln(ba, dm, 1, 1);
+    MultiFab soln_fresh(ba, dm, 1, 1);
+
+    // Neumann boundaries make the problem singular once alpha is zero.
+    const LinOpBCType bctype = singular ? LinOpBCType::Neumann : LinOpBCType::Dirichlet;
+    const Array<LinOpBCType,AMREX_SPACEDIM> bc{AMREX_D_DECL(bctype,bctype,bctype)};
+
+    auto setup = [&] (MLABecLaplacian& mlabec, Real a, Real eps)
+    {
+        mlabec.setDomainBC(bc, bc);
+        mlabec.setLevelBC(0, nullptr);
+        mlabec.setScalars(1.0, 1.0);
+        setCoeffs(geom, alpha, beta, a, eps);
+        mlabec.setACoeffs(0, alpha);
+        mlabec.setBCoeffs(0, amrex::GetArrOfConstPtrs(beta));
+    };
+
+    MLABecLaplacian mlabec({geom}, {ba}, {dm});
+    mlabec.setMaxOrder(2);
+    mlabec.setCoeffsReuseTolerance(parms.reuse_rtol);
+    setup(mlabec, 1.0, 0.0);
+    MLMG mlmg(mlabec);
+    solve(mlmg, soln, rhs);
+
+    // Change the coefficients by less than the tolerance.  Without a change
+    // of singularity the coarse data are kept.
+    const Real a1 = singular ? 0.0 : 1.0;
+    const Real eps = 0.5*parms.reuse_rtol;
+    setCoeffs(geom, alpha, beta, a1, eps);
+    mlabec.setACoeffs(0, alpha);
+    mlabec.setBCoeffs(0, amrex::GetArrOfConstPtrs(beta));
+    solve(mlmg, soln, rhs);
+    AMREX_ALWAYS_ASSERT(mlabec.reusedCoarseData() == !singular);
+    AMREX_ALWAYS_ASSERT(mlabec.isSingular(0) == singular);
+
+    MLABecLaplacian mlabec_fresh({geom}, {ba}, {dm});
+    mlabec_fresh.setMaxOrder(2);
+    setup(mlabec_fresh, a1, eps);
+    MLMG mlmg_fresh(mlabec_fresh);
+    solve(mlmg_fresh, soln_fresh, rhs);
+
+    const Real err = maxDiff(soln, soln_fresh, singular);
+    amrex::Print() << (singular ? "singular" : "regular ") << " problem: reused coarse data "
+                   << mlabec.reusedCoarseData() << ", max relative difference " << err << "\n";
+    AMREX_ALWAYS_ASSERT(err < 1.e-8);
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+
+    ParmParse pp;
+    TestParams parms;
+    pp.get("n_cell", parms.n_cell);
+    pp.get("max_grid_size", parms.max_grid_size);
+    pp.get("reuse_rtol", parms.reuse_rtol);
+
+    testReuse(parms, false);
+    testReuse(parms, true);
+
+    amrex::Finalize();
+}
@@ -0,0 +1,126 @@
+
+#include <AMReX.H>
+#include <AMReX_Print.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Utility.H>
+
+using namespace amrex;
+
+void test ();
+void laplacian (MultiFab& lap, MultiFab const& phi, const Box& bx, const MFIter& mfi, int ng);
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    test();
+    amrex::Finalize();
+}
+
+// Times a stencil update after a blocking FillBoundary and overlapped with
+// FillBoundary by MFOverlapIter, and checks that they agree exactly.
+void test ()
+{
+    int n_cell = 128;
+    int max_grid_size = 32;
+    int ng = 1;
+    int nrepeat = 10;
+    {
+        ParmParse pp;
+        pp.query("n_cell", n_cell);
+        pp.query("max_grid_size", max_grid_size);
+        pp.query("ng", ng);
+        pp.query("nrepeat", nrepeat);
+    }
+
+    const Box domain(IntVect(0), IntVect(n_cell-1));
+    BoxArray ba(domain);
+    ba.maxSize(max_grid_size);
+    DistributionMapping dm(ba);
+    const Periodicity period(domain.size());
+
+    MultiFab phi(ba, dm, 1, ng);
+    MultiFab lap1(ba, dm, 1, 0);
+    MultiFab lap2(ba, dm, 1, 0);
+    MultiFab ntouch(ba, dm, 1, 0);
+
+    for (MFIter mfi(phi); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.validbox();
+        auto const& a = phi.array(mfi);
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            a(i,j,k) = std::sin(0.1*i+0.2*j+0.3*k);
+        });
+    }
+
+    // Every valid cell is in exactly one tile.  The loops over MFOverlapIter
+    // run on all the threads, so that the interior tiles of the threads and
+    // the FillBoundary_finish between them and the boundary tiles are tested.
+    ntouch.setVal(0.0);
+    phi.FillBoundary_nowait(period);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFOverlapIter mfi(phi, IntVect(ng), MFItInfo().EnableTiling()); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.tilebox();
+        auto const& a = ntouch.array(mfi);
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            a(i,j,k) += 1.0;
+        });
+    }
+    AMREX_ALWAYS_ASSERT(ntouch.min(0) == 1.0 && ntouch.max(0) == 1.0);
+
+    Real t0 = amrex::second();
+    for (int irepeat = 0; irepeat < nrepeat; ++irepeat) {
+        phi.FillBoundary(period);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(phi, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+            laplacian(lap1, phi, mfi.tilebox(), mfi, ng);
+        }
+    }
+    ParallelDescriptor::Barrier();
+    const Real t_blocking = (amrex::second() - t0) / nrepeat;
+
+    t0 = amrex::second();
+    for (int irepeat = 0; irepeat < nrepeat; ++irepeat) {
+        phi.FillBoundary_nowait(period);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFOverlapIter mfi(phi, IntVect(ng), MFItInfo().EnableTiling()); mfi.isValid(); ++mfi) {
+            laplacian(lap2, phi, mfi.tilebox(), mfi, ng);
+        }
+    }
+    ParallelDescriptor::Barrier();
+    const Real t_overlap = (amrex::second() - t0) / nrepeat;
+
+    MultiFab::Subtract(lap2, lap1, 0, 0, 1, 0);
+    const Real diff = lap2.norm0();
+
+    amrex::Print() << ba.size() << " boxes, stencil width " << ng << "\n"
+                   << "    blocking FillBoundary " << t_blocking << " s, overlapped "
+                   << t_overlap << " s, max difference " << diff << "\n";
+
+    // The same stencil on the same data gives the same bits.
+    AMREX_ALWAYS_ASSERT(diff == 0.0);
+}
+
+// A wide Laplacian-like stencil that reads ng cells on each side.
+void laplacian (MultiFab& lap, MultiFab const& phi, const Box& bx, const MFIter& mfi, int ng)
+{
+    auto const& l = lap.array(mfi);
+    auto const& p = phi.const_array(mfi);
+    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        Real r = -2.0*AMREX_SPACEDIM*ng*p(i,j,k);
+        for (int m = 1; m <= ng; ++m) {
+            r += AMREX_D_TERM(p(i-m,j,k) + p(i+m,j,k),
+                            + p(i,j-m,k) + p(i,j+m,k),
+                            + p(i,j,k-m) + p(i,j,k+m));
+        }
+        l(i,j,k) = r;
+    });
+}
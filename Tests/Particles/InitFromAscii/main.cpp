@@ -1,4 +1,7 @@
 #include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 #include <AMReX.H>
 #include <AMReX_MultiFab.H>
@@ -13,9 +16,81 @@ struct TestParams {
   int ny;
   int nz;
   int max_grid_size;
+  Long nparticles;
   bool verbose;
 };
 
+typedef ParticleContainer<1, 0, AMREX_SPACEDIM> MyParticleContainer;
+
+Real sumRealData (const MyParticleContainer& myPC, int ncomp)
+{
+    using PType = MyParticleContainer::SuperParticleType;
+    Real sum = amrex::ReduceSum(myPC,
+                                [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
+                                {
+                                    Real total = 0.0;
+                                    for (int i = 0; i < ncomp; ++i)
+                                    {
+                                        total += p.rdata(i);
+                                    }
+                                    return total;
+                                });
+    ParallelDescriptor::ReduceRealSum(sum);
+    return sum;
+}
+
+void test_parse_real ()
+{
+    // The fast parser must agree bit for bit with strtod.
+    amrex::InitRandom(1);
+    const char* formats[] = {"%.17g", "%.6f", "%.3e", "%.10g", "%g"};
+    char str[64];
+    for (int i = 0; i < 100000; ++i)
+    {
+        const double x = (amrex::Random() - 0.5) * std::pow(10.0, amrex::Random_int(40) - 20);
+        std::snprintf(str, sizeof(str), formats[i % 5], x);
+        const char* p = str;
+        double v;
+        AMREX_ALWAYS_ASSERT(parseParticleReal(p, str + std::strlen(str), v));
+        AMREX_ALWAYS_ASSERT(*p == '\0');
+        AMREX_ALWAYS_ASSERT(v == std::strtod(str, nullptr));
+    }
+}
+
+void write_particle_files (const Geometry& geom, Long np)
+{
+    if (ParallelDescriptor::IOProcessor())
+    {
+        amrex::InitRandom(2);
+
+        std::ofstream txt("particles_big.txt");
+        std::ofstream bin("particles_big.bin", std::ios::binary);
+        txt.precision(10);
+        txt << np << "\n";
+
+        int DM = AMREX_SPACEDIM;
+        int NX = 1;
+        bin.write((char*)&np, sizeof(np));
+        bin.write((char*)&DM, sizeof(DM));
+        bin.write((char*)&NX, sizeof(NX));
+
+        double v[AMREX_SPACEDIM+1];
+        for (Long i = 0; i < np; ++i)
+        {
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                v[d] = geom.ProbLo(d) + amrex::Random()*geom.ProbLength(d);
+            }
+            v[AMREX_SPACEDIM] = amrex::Random();
+
+            for (int d = 0; d <= AMREX_SPACEDIM; ++d) {
+                txt << v[d] << (d < AMREX_SPACEDIM ? " " : "\n");
+            }
+            bin.write((char*)v, sizeof(v));
+        }
+    }
+    ParallelDescriptor::Barrier();
+}
+
 void test_init_ascii (TestParams& parms)
 {
     RealBox real_box;
@@ -24,58 +99,125 @@ void test_init_ascii (TestParams& parms)
         real_box.setLo(n, 0.0);
         real_box.setHi(n, 1.0);
     }
-    
+
     IntVect domain_lo(AMREX_D_DECL(0, 0, 0));
     IntVect domain_hi(AMREX_D_DECL(parms.nx - 1, parms.ny - 1, parms.nz-1));
     const Box domain(domain_lo, domain_hi);
-    
+
     // This sets the boundary conditions to be doubly or triply periodic
     int is_per[AMREX_SPACEDIM];
-    for (int i = 0; i < AMREX_SPACEDIM; i++) 
+    for (int i = 0; i < AMREX_SPACEDIM; i++)
         is_per[i] = 1;
     Geometry geom(domain, &real_box, CoordSys::cartesian, is_per);
-    
+
     BoxArray ba(domain);
     ba.maxSize(parms.max_grid_size);
 
     DistributionMapping dmap(ba);
 
-    typedef ParticleContainer<1, 0, AMREX_SPACEDIM> MyParticleContainer;
-    MyParticleContainer myPC(geom, dmap, ba);
+    {
+        MyParticleContainer myPC(geom, dmap, ba);
 
-    myPC.InitFromAsciiFile("particles.txt", 1 + AMREX_SPACEDIM);
+        myPC.InitFromAsciiFile("particles.txt", 1 + AMREX_SPACEDIM);
 
-    // should be 8
-    amrex::Print() << myPC.TotalNumberOfParticles() << "\n";
+        // should be 8
+        amrex::Print() << myPC.TotalNumberOfParticles() << "\n";
 
-    // should be 8010.0
-    using PType = MyParticleContainer::SuperParticleType;
-    amrex::Print() << amrex::ReduceSum(myPC,
-                                       [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-                                       {
-                                           Real total = 0.0;
-                                           for (int i = 0; i < 1 + AMREX_SPACEDIM; ++i)
-                                           {
-                                               total += p.rdata(i);
-                                           }
-                                           return total;
-                                       })
-                   << "\n";
+        // should be 8010.0
+        amrex::Print() << sumRealData(myPC, 1 + AMREX_SPACEDIM) << "\n";
+    }
+
+    {
+        MyParticleContainer myPC(geom, dmap, ba);
+
+        myPC.InitFromAsciiFileParallel("particles.txt", 1 + AMREX_SPACEDIM);
+
+        AMREX_ALWAYS_ASSERT(myPC.TotalNumberOfParticles() == 8);
+        AMREX_ALWAYS_ASSERT(sumRealData(myPC, 1 + AMREX_SPACEDIM) == 8010.0);
+    }
+
+    if (parms.nparticles <= 0) return;
+
+    write_particle_files(geom, parms.nparticles);
+
+    const Real expected_sum = 0.5 * (AMREX_SPACEDIM + 1) * parms.nparticles;
+
+    auto check = [&] (const std::string& name, const MyParticleContainer& myPC, Real t,
+                      Real& sum)
+    {
+        AMREX_ALWAYS_ASSERT(myPC.TotalNumberOfParticles() == parms.nparticles);
+        AMREX_ALWAYS_ASSERT(myPC.OK());
+
+        using PType = MyParticleContainer::SuperParticleType;
+        sum = amrex::ReduceSum(myPC,
+                               [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
+                               {
+                                   return AMREX_D_TERM(p.pos(0), + p.pos(1), + p.pos(2))
+                                       + p.rdata(0);
+                               });
+        ParallelDescriptor::ReduceRealSum(sum);
+        // The positions are uniform in [0,1)^D and the data in [0,1).
+        AMREX_ALWAYS_ASSERT(std::abs(sum - expected_sum) < 0.01*expected_sum);
+
+        amrex::Print() << "    " << name << ": " << t << " s, "
+                       << parms.nparticles/t/1.e6 << " Mparticles/s\n";
+    };
+
+    amrex::Print() << "Reading " << parms.nparticles << " particles:\n";
+
+    Real sums[4];
+    {
+        MyParticleContainer myPC(geom, dmap, ba);
+        Real t = amrex::second();
+        myPC.InitFromAsciiFile("particles_big.txt", 1);
+        check("InitFromAsciiFile         ", myPC, amrex::second() - t, sums[0]);
+    }
+    {
+        MyParticleContainer myPC(geom, dmap, ba);
+        myPC.SetVerbose(parms.verbose);
+        Real t = amrex::second();
+        myPC.InitFromAsciiFileParallel("particles_big.txt", 1);
+        check("InitFromAsciiFileParallel ", myPC, amrex::second() - t, sums[1]);
+    }
+    {
+        MyParticleContainer myPC(geom, dmap, ba);
+        Real t = amrex::second();
+        myPC.InitFromBinaryFile("particles_big.bin", 1);
+        check("InitFromBinaryFile        ", myPC, amrex::second() - t, sums[2]);
+    }
+    {
+        MyParticleContainer myPC(geom, dmap, ba);
+        myPC.SetVerbose(parms.verbose);
+        Real t = amrex::second();
+        myPC.InitFromBinaryFileParallel("particles_big.bin", 1);
+        check("InitFromBinaryFileParallel", myPC, amrex::second() - t, sums[3]);
+    }
+
+    // The particles only differ in the order in which they are summed.
+    for (int i = 1; i < 4; ++i) {
+        AMREX_ALWAYS_ASSERT(std::abs(sums[i] - sums[0]) < 1.e-8*std::abs(sums[0]));
+    }
 }
 
 int main(int argc, char* argv[])
 {
   amrex::Initialize(argc,argv);
-  
+
   ParmParse pp;
-  
-  TestParams parms; 
+
+  TestParams parms;
   pp.get("nx", parms.nx);
   pp.get("ny", parms.ny);
   pp.get("nz", parms.nz);
   pp.get("max_grid_size", parms.max_grid_size);
-  
+  parms.nparticles = 0;
+  pp.query("nparticles", parms.nparticles);
+  parms.verbose = false;
+  pp.query("verbose", parms.verbose);
+
+  test_parse_real();
+
   test_init_ascii(parms);
-  
+
   amrex::Finalize();
 }
@@ -11,6 +11,7 @@ struct TestParams {
     int max_grid_size;
     int is_periodic;
     int nlevs;
+    int nparticles;
 };
 
 void get_test_params(TestParams& params, const std::string& prefix)
@@ -20,13 +21,13 @@ void get_test_params(TestParams& params, const std::string& prefix)
     pp.get("max_grid_size", params.max_grid_size);
     pp.get("is_periodic", params.is_periodic);
     pp.get("nlevs", params.nlevs);
+    params.nparticles = 0;
+    pp.query("nparticles", params.nparticles);
 }
 
-void testIntersection()
+void makeHierarchy (const TestParams& params, Vector<Geometry>& geom, Vector<BoxArray>& ba)
 {
-    TestParams params;
-    get_test_params(params, "intersect");
-    
+
     int is_per[BL_SPACEDIM];
     for (int i = 0; i < BL_SPACEDIM; i++)
         is_per[i] = params.is_periodic;
@@ -46,14 +47,14 @@ void testIntersection()
     IntVect domain_hi(AMREX_D_DECL(params.size[0]-1, params.size[1]-1, params.size[2]-1));
     const Box base_domain(domain_lo, domain_hi);
     
-    Vector<Geometry> geom(params.nlevs);
+    geom.resize(params.nlevs);
     geom[0].define(base_domain, &real_box, CoordSys::cartesian, is_per);
     for (int lev = 1; lev < params.nlevs; lev++) {
         geom[lev].define(amrex::refine(geom[lev-1].Domain(), rr[lev-1]),
                          &real_box, CoordSys::cartesian, is_per);
     }
     
-    Vector<BoxArray> ba(params.nlevs);
+    ba.resize(params.nlevs);
     IntVect lo = IntVect(AMREX_D_DECL(0, 0, 0));
     IntVect size = params.size;
     for (int lev = 0; lev < params.nlevs; ++lev)
@@ -63,8 +64,18 @@ void testIntersection()
         lo += size/2;
         size *= 2;
     }
+}
 
-    Vector<ParticleLocator> ploc(params.nlevs);
+void testIntersection()
+{
+    TestParams params;
+    get_test_params(params, "intersect");
+
+    Vector<Geometry> geom;
+    Vector<BoxArray> ba;
+    makeHierarchy(params, geom, ba);
+
+    Vector<ParticleLocator<DenseBins<Box> > > ploc(params.nlevs);
 
     for (int lev = 0; lev < params.nlevs; ++lev)
     {
@@ -112,11 +123,84 @@ void testIntersection()
     }
 }
 
+void testAmrLocator()
+{
+    TestParams params;
+    get_test_params(params, "intersect");
+    if (params.nparticles <= 0) return;
+
+    Vector<Geometry> geom;
+    Vector<BoxArray> ba;
+    makeHierarchy(params, geom, ba);
+
+    AmrParticleLocator<DenseBins<Box> > ploc(ba, geom);
+    AMREX_ALWAYS_ASSERT(ploc.isValid(ba));
+    auto assign_grid = ploc.getGridAssignor();
+
+    using PType = Particle<0, 0>;
+    const int np = params.nparticles;
+    Gpu::HostVector<PType> host_particles(np);
+    for (auto& p : host_particles) {
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) p.pos(d) = amrex::Random();
+    }
+    Gpu::DeviceVector<PType> particles(np);
+    Gpu::copy(Gpu::hostToDevice, host_particles.begin(), host_particles.end(), particles.begin());
+    const auto p_ptr = particles.dataPtr();
+
+    // The assignment without a cached grid.
+    Gpu::DeviceVector<int> grids(np), levs(np);
+    const auto grids_ptr = grids.dataPtr();
+    const auto levs_ptr = levs.dataPtr();
+    Real t_full = amrex::second();
+    amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int i) noexcept
+    {
+        const auto tup = assign_grid(p_ptr[i]);
+        grids_ptr[i] = amrex::get<0>(tup);
+        levs_ptr[i]  = amrex::get<1>(tup);
+    });
+    Gpu::synchronize();
+    t_full = amrex::second() - t_full;
+
+    // With the right grid cached, the wrong one, or none, the answer
+    // must be the same.
+    Gpu::DeviceVector<int> num_wrong(1, 0);
+    const auto wrong_ptr = num_wrong.dataPtr();
+    const int nlevs = params.nlevs;
+    Real t_cached = 0.0;
+    for (int shift = 0; shift < 3; ++shift)
+    {
+        Real t = amrex::second();
+        amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int i) noexcept
+        {
+            const int clev = (shift == 1) ? (levs_ptr[i] + 1) % nlevs : levs_ptr[i];
+            const int cgrid = (shift == 0) ? grids_ptr[i] : (shift == 1 ? 0 : grids_ptr[i] + 1);
+            const auto tup = assign_grid(p_ptr[i], -1, -1, 0, clev, cgrid);
+            if (amrex::get<0>(tup) != grids_ptr[i] || amrex::get<1>(tup) != levs_ptr[i]) {
+                Gpu::Atomic::Add(wrong_ptr, 1);
+            }
+        });
+        Gpu::synchronize();
+        if (shift == 0) t_cached = amrex::second() - t;
+    }
+    int h_wrong = 0;
+    Gpu::copy(Gpu::deviceToHost, num_wrong.begin(), num_wrong.end(), &h_wrong);
+    AMREX_ALWAYS_ASSERT(h_wrong == 0);
+
+    // Rebuilding with the same boxes is not needed.
+    Vector<BoxArray> ba_copy = ba;
+    AMREX_ALWAYS_ASSERT(ploc.isValid(ba_copy));
+
+    amrex::Print() << "AmrParticleLocator: " << np/t_full/1.e6 << " Mparticles/s, "
+                   << np/t_cached/1.e6 << " Mparticles/s with the grid cached\n";
+}
+
 int main(int argc, char* argv[])
 {
     amrex::Initialize(argc,argv);
     
     testIntersection();
+
+    testAmrLocator();
     
     amrex::Finalize();
 }
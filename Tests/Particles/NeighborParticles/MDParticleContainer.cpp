@@ -221,6 +221,135 @@ void MDParticleContainer::moveParticles(amrex::Real dx)
     }
 }
 
+namespace
+{
+    // A velocity-dependent pair force, so that it does not vanish on a lattice.
+    // The force on p2 is minus the force on p1.
+    template <class P>
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void pair_force (const P& p1, const P& p2, Real cutoff_sq, Real* f)
+    {
+        Real dx = p1.pos(0) - p2.pos(0);
+        Real dy = p1.pos(1) - p2.pos(1);
+        Real dz = p1.pos(2) - p2.pos(2);
+        Real w = cutoff_sq - (dx*dx + dy*dy + dz*dz);
+        f[0] = w*(p2.rdata(PIdx::vx) - p1.rdata(PIdx::vx));
+        f[1] = w*(p2.rdata(PIdx::vy) - p1.rdata(PIdx::vy));
+        f[2] = w*(p2.rdata(PIdx::vz) - p1.rdata(PIdx::vz));
+    }
+
+    template <class P>
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void add_pair_force (P* pstruct, int i, int j, Real cutoff_sq)
+    {
+        Real f[3];
+        pair_force(pstruct[i], pstruct[j], cutoff_sq, f);
+        for (int d = 0; d < 3; ++d) {
+            Gpu::Atomic::AddNoRet(&(pstruct[i].rdata(PIdx::ax+d)),  f[d]);
+            Gpu::Atomic::AddNoRet(&(pstruct[j].rdata(PIdx::ax+d)), -f[d]);
+        }
+    }
+}
+
+void MDParticleContainer::computeForces(ForceMethod method, Real cutoff)
+{
+    BL_PROFILE("MDParticleContainer::computeForces");
+
+    const int lev = 0;
+    auto& plev  = GetParticles(lev);
+    const Real cutoff_sq = cutoff*cutoff;
+
+    for (MFIter mfi = MakeMFIter(lev); mfi.isValid(); ++mfi)
+    {
+        auto index = std::make_pair(mfi.index(), mfi.LocalTileIndex());
+        auto& aos = plev[index].GetArrayOfStructs();
+        const int np_total = aos.numTotalParticles();
+        ParticleType* pstruct = aos().dataPtr();
+
+        AMREX_FOR_1D ( np_total, i,
+        {
+            for (int d = 0; d < 3; ++d) {
+                pstruct[i].rdata(PIdx::ax+d) = 0.0;
+            }
+        });
+    }
+
+    if (method == ForceMethod::CellPairs)
+    {
+        forEachCellPair(CheckPairRadius(cutoff),
+            [=] AMREX_GPU_HOST_DEVICE (ParticleTileType::ParticleTileDataType const& ptd,
+                                       int i, int j)
+            {
+                add_pair_force(ptd.m_aos, i, j, cutoff_sq);
+            });
+    }
+    else
+    {
+        for (MFIter mfi = MakeMFIter(lev); mfi.isValid(); ++mfi)
+        {
+            auto index = std::make_pair(mfi.index(), mfi.LocalTileIndex());
+            auto& aos = plev[index].GetArrayOfStructs();
+            const int np = aos.numParticles();
+            ParticleType* pstruct = aos().dataPtr();
+
+            auto nbor_data = m_neighbor_list[lev][index].data();
+
+            if (method == ForceMethod::FullList)
+            {
+                AMREX_FOR_1D ( np, i,
+                {
+                    for (auto mit = nbor_data.getNeighbors(i).begin();
+                         mit != nbor_data.getNeighbors(i).end(); ++mit)
+                    {
+                        Real f[3];
+                        pair_force(pstruct[i], *mit, cutoff_sq, f);
+                        for (int d = 0; d < 3; ++d) {
+                            pstruct[i].rdata(PIdx::ax+d) += f[d];
+                        }
+                    }
+                });
+            }
+            else
+            {
+                AMREX_FOR_1D ( np, i,
+                {
+                    for (auto mit = nbor_data.getNeighbors(i).begin();
+                         mit != nbor_data.getNeighbors(i).end(); ++mit)
+                    {
+                        add_pair_force(pstruct, i, mit.index(), cutoff_sq);
+                    }
+                });
+            }
+        }
+    }
+
+    if (method != ForceMethod::FullList) {
+        sumTileNeighbors(PIdx::ax, 3, 0, 0);
+    }
+}
+
+Vector<Real> MDParticleContainer::getForces()
+{
+    const int lev = 0;
+    auto& plev  = GetParticles(lev);
+
+    Vector<Real> forces;
+    for (MFIter mfi = MakeMFIter(lev); mfi.isValid(); ++mfi)
+    {
+        auto index = std::make_pair(mfi.index(), mfi.LocalTileIndex());
+        auto& aos = plev[index].GetArrayOfStructs();
+        Gpu::HostVector<ParticleType> host_particles(aos.numParticles());
+        Gpu::copy(Gpu::deviceToHost, aos().begin(), aos().begin() + aos.numParticles(),
+                  host_particles.begin());
+        for (const auto& p : host_particles) {
+            for (int d = 0; d < 3; ++d) {
+                forces.push_back(p.rdata(PIdx::ax+d));
+            }
+        }
+    }
+    return forces;
+}
+
 void MDParticleContainer::writeParticles(const int n)
 {
     BL_PROFILE("MDParticleContainer::writeParticles");
@@ -322,7 +451,7 @@ void MDParticleContainer::checkNeighborParticles()
 #endif
 }
 
-void MDParticleContainer::checkNeighborList()
+void MDParticleContainer::checkNeighborList(Real cutoff_sq)
 {
     BL_PROFILE("MDParticleContainer::checkNeighborList");
 
@@ -383,8 +512,6 @@ void MDParticleContainer::checkNeighborList()
                 
                 Real r2 = dx*dx + dy*dy + dz*dz;
 
-                Real cutoff_sq = 25.0*Params::cutoff*Params::cutoff; 
-
 		if (r2 <= cutoff_sq)
 		{
                    Gpu::Atomic::AddNoRet(&(p_full_count[i]),1);
@@ -22,6 +22,10 @@ void testNeighborParticles();
 
 void testNeighborList();
 
+void testVerletList();
+
+void testHalfNeighborList();
+
 int main (int argc, char* argv[])
 {
     amrex::Initialize(argc,argv);
@@ -32,6 +36,12 @@ int main (int argc, char* argv[])
     amrex::PrintToFile("neighbor_test") << "Running neighbor list test \n";
     testNeighborList();
 
+    amrex::PrintToFile("neighbor_test") << "Running Verlet list test \n";
+    testVerletList();
+
+    amrex::PrintToFile("neighbor_test") << "Running half neighbor list test \n";
+    testHalfNeighborList();
+
     amrex::Finalize();
 }
 
@@ -184,3 +194,145 @@ void testNeighborList ()
 
     pc.checkNeighborList();
 }
+
+void testVerletList ()
+{
+    BL_PROFILE("testVerletList");
+    TestParams params;
+    get_test_params(params, "nbor_list");
+
+    RealBox real_box;
+    for (int n = 0; n < BL_SPACEDIM; n++)
+    {
+        real_box.setLo(n, 0.0);
+        real_box.setHi(n, params.size[n]);
+    }
+
+    IntVect domain_lo(AMREX_D_DECL(0, 0, 0));
+    IntVect domain_hi(AMREX_D_DECL(params.size[0]-1,params.size[1]-1,params.size[2]-1));
+    const Box domain(domain_lo, domain_hi);
+
+    int coord = 0;
+    int is_per[BL_SPACEDIM];
+    for (int i = 0; i < BL_SPACEDIM; i++)
+        is_per[i] = params.is_periodic;
+    Geometry geom(domain, &real_box, coord, is_per);
+
+    BoxArray ba(domain);
+    ba.maxSize(params.max_grid_size);
+    DistributionMapping dm(ba);
+
+    // The list radius, cutoff + skin, must fit in the neighbor cells. It is
+    // chosen away from the lattice distances 1, sqrt(2) and sqrt(3) so that
+    // the brute force check is not sensitive to roundoff.
+    const int ncells = 2;
+    const Real cutoff = 1.3;
+    const Real skin = 0.2;
+    MDParticleContainer pc(geom, dm, ba, ncells);
+    pc.setNeighborListSkin(skin);
+
+    int npc = params.num_ppc;
+    IntVect nppc = IntVect(AMREX_D_DECL(npc, npc, npc));
+
+    pc.InitParticles(nppc, 1.0, 0.0);
+    pc.fillNeighbors();
+    pc.buildNeighborList(CheckPairRadius(cutoff+skin));
+    pc.checkNeighborList((cutoff+skin)*(cutoff+skin));
+
+    // Each step moves every particle by 0.02*sqrt(3), so the displacement
+    // exceeds half the skin on every third step.
+    const int nsteps = 8;
+    int nrebuilds = 0;
+    for (int step = 1; step <= nsteps; ++step)
+    {
+        pc.moveParticles(0.02);
+        bool rebuilt = pc.updateNeighborList(CheckPairRadius(cutoff+skin));
+        amrex::PrintToFile("neighbor_test") << "Step " << step << ": neighbor list "
+                                            << (rebuilt ? "rebuilt" : "reused") << "\n";
+        if (rebuilt) ++nrebuilds;
+        pc.checkNeighborList((cutoff+skin)*(cutoff+skin));
+    }
+
+    if (nrebuilds != nsteps/3)
+    {
+        amrex::PrintToFile("neighbor_test") << "Neighbor list was rebuilt " << nrebuilds
+                                            << " times, should be " << nsteps/3 << "\n";
+        amrex::Abort();
+    }
+}
+
+void testHalfNeighborList ()
+{
+    BL_PROFILE("testHalfNeighborList");
+    TestParams params;
+    get_test_params(params, "nbor_list");
+
+    RealBox real_box;
+    for (int n = 0; n < BL_SPACEDIM; n++)
+    {
+        real_box.setLo(n, 0.0);
+        real_box.setHi(n, params.size[n]);
+    }
+
+    IntVect domain_lo(AMREX_D_DECL(0, 0, 0));
+    IntVect domain_hi(AMREX_D_DECL(params.size[0]-1,params.size[1]-1,params.size[2]-1));
+    const Box domain(domain_lo, domain_hi);
+
+    int coord = 0;
+    int is_per[BL_SPACEDIM];
+    for (int i = 0; i < BL_SPACEDIM; i++)
+        is_per[i] = params.is_periodic;
+    Geometry geom(domain, &real_box, coord, is_per);
+
+    BoxArray ba(domain);
+    ba.maxSize(params.max_grid_size);
+    DistributionMapping dm(ba);
+
+    const int ncells = 2;
+    const Real cutoff = 1.5;
+    MDParticleContainer pc(geom, dm, ba, ncells);
+
+    // sumNeighbors needs the inverse copy information
+    pc.setEnableInverse(true);
+
+    int npc = params.num_ppc;
+    IntVect nppc = IntVect(AMREX_D_DECL(npc, npc, npc));
+
+    pc.InitParticles(nppc, 1.0, 0.0);
+    pc.fillNeighbors();
+
+    pc.buildNeighborList(CheckPairRadius(cutoff));
+    pc.computeForces(MDParticleContainer::ForceMethod::FullList, cutoff);
+    const auto full = pc.getForces();
+
+    pc.setHalfNeighborList(true);
+    pc.buildNeighborList(CheckPairRadius(cutoff));
+    pc.computeForces(MDParticleContainer::ForceMethod::HalfList, cutoff);
+    const auto half = pc.getForces();
+
+    pc.computeForces(MDParticleContainer::ForceMethod::CellPairs, cutoff);
+    const auto cell = pc.getForces();
+
+    Real max_force = 0.0;
+    Real max_diff_half = 0.0;
+    Real max_diff_cell = 0.0;
+    for (int i = 0; i < full.size(); ++i)
+    {
+        max_force = std::max(max_force, std::abs(full[i]));
+        max_diff_half = std::max(max_diff_half, std::abs(half[i]-full[i]));
+        max_diff_cell = std::max(max_diff_cell, std::abs(cell[i]-full[i]));
+    }
+    ParallelDescriptor::ReduceRealMax(max_force);
+    ParallelDescriptor::ReduceRealMax(max_diff_half);
+    ParallelDescriptor::ReduceRealMax(max_diff_cell);
+
+    amrex::PrintToFile("neighbor_test") << "Max force " << max_force
+                                        << ", max difference to full list: half list "
+                                        << max_diff_half << ", cell pairs "
+                                        << max_diff_cell << "\n";
+
+    if (max_force == 0.0 || max_diff_half > 1.e-10*max_force || max_diff_cell > 1.e-10*max_force)
+    {
+        amrex::Abort("Half list forces do not match the full list");
+    }
+}
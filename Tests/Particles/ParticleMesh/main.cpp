@@ -16,53 +16,16 @@ struct TestParams {
   int max_grid_size;
   int nppc;
   bool verbose;
+  bool sort_timing;
+  bool soa_timing;
+  bool shape_timing;
 };
 
-void testParticleMesh(TestParams& parms)
-{
-
-  RealBox real_box;
-  for (int n = 0; n < BL_SPACEDIM; n++) {
-    real_box.setLo(n, 0.0);
-    real_box.setHi(n, 1.0);
-  }
-
-  IntVect domain_lo(AMREX_D_DECL(0, 0, 0));
-  IntVect domain_hi(AMREX_D_DECL(parms.nx - 1, parms.ny - 1, parms.nz-1));
-  const Box domain(domain_lo, domain_hi);
-
-  // This sets the boundary conditions to be doubly or triply periodic
-  int is_per[BL_SPACEDIM];
-  for (int i = 0; i < BL_SPACEDIM; i++) 
-    is_per[i] = 1; 
-  Geometry geom(domain, &real_box, CoordSys::cartesian, is_per);
-
-  BoxArray ba(domain);
-  ba.maxSize(parms.max_grid_size);
-  if (parms.verbose && ParallelDescriptor::IOProcessor()) {
-    std::cout << "Number of boxes              : " << ba[0].size() << '\n' << '\n';
-  }
-
-  DistributionMapping dmap(ba);
-
-  MultiFab partMF(ba, dmap, 1 + BL_SPACEDIM, 1);
-  partMF.setVal(0.0);
-
-  typedef ParticleContainer<1 + 2*BL_SPACEDIM> MyParticleContainer;
-  MyParticleContainer myPC(geom, dmap, ba);
-  myPC.SetVerbose(false);
-
-  int num_particles = parms.nppc * parms.nx * parms.ny * parms.nz;
-  if (ParallelDescriptor::IOProcessor())
-    std::cout << "Total number of particles    : " << num_particles << '\n' << '\n';
-
-  bool serialize = true;
-  int iseed = 451;
-  Real mass = 10.0;
-
-  MyParticleContainer::ParticleInitData pdata = {mass, AMREX_D_DECL(1.0, 2.0, 3.0), AMREX_D_DECL(0.0, 0.0, 0.0)};
-  myPC.InitRandom(num_particles, iseed, pdata, serialize);
+typedef ParticleContainer<1 + 2*BL_SPACEDIM> MyParticleContainer;
+typedef ParIter<1 + 2*BL_SPACEDIM> MyParIter;
 
+void depositCIC (MyParticleContainer& myPC, MultiFab& partMF, const Geometry& geom)
+{
   int nc = 1 + BL_SPACEDIM;
   const auto plo = geom.ProbLoArray();
   const auto dxi = geom.InvCellSizeArray();
@@ -106,11 +69,13 @@ void testParticleMesh(TestParams& parms)
               }
           }
       });
+}
 
-  MultiFab acceleration(ba, dmap, BL_SPACEDIM, 1);
-  acceleration.setVal(5.0);
-
-  nc = BL_SPACEDIM;
+void interpolateCIC (MyParticleContainer& myPC, const MultiFab& acceleration, const Geometry& geom)
+{
+  int nc = BL_SPACEDIM;
+  const auto plo = geom.ProbLoArray();
+  const auto dxi = geom.InvCellSizeArray();
   amrex::MeshToParticle(myPC, acceleration, 0,
       [=] AMREX_GPU_DEVICE (MyParticleContainer::ParticleType& p,
                             amrex::Array4<const amrex::Real> const& acc)
@@ -141,12 +106,491 @@ void testParticleMesh(TestParams& parms)
               }
           }
       });
+}
+
+//
+// The same deposition and interpolation with all the attributes stored as
+// struct-of-arrays components, using the ParticleTileData form of the
+// functions so that only the arrays that are needed are touched.
+//
+// The same kernels also run on the pure struct-of-arrays layout, which
+// stores the positions, ids and cpus as components as well.
+//
+typedef ParticleContainer<0, 0, 1 + 2*BL_SPACEDIM> MySoAParticleContainer;
+typedef SoAParticleContainer<1 + 2*BL_SPACEDIM> MyPureSoAParticleContainer;
+
+template <class PC, typename std::enable_if<PC::NStructReal == 0, int>::type = 0>
+void depositCIC (PC& myPC, MultiFab& partMF, const Geometry& geom)
+{
+  using MyConstSoATileData = typename PC::ParticleTileType::ConstParticleTileDataType;
+  int nc = 1 + BL_SPACEDIM;
+  const auto plo = geom.ProbLoArray();
+  const auto dxi = geom.InvCellSizeArray();
+  amrex::ParticleToMesh(myPC, partMF, 0,
+      [=] AMREX_GPU_DEVICE (const MyConstSoATileData& ptd, int ip,
+                            amrex::Array4<amrex::Real> const& rho)
+      {
+          amrex::Real lx = (ptd.pos(0,ip) - plo[0]) * dxi[0] + 0.5;
+          amrex::Real ly = (ptd.pos(1,ip) - plo[1]) * dxi[1] + 0.5;
+          amrex::Real lz = (ptd.pos(2,ip) - plo[2]) * dxi[2] + 0.5;
+
+          int i = amrex::Math::floor(lx);
+          int j = amrex::Math::floor(ly);
+          int k = amrex::Math::floor(lz);
+
+          amrex::Real xint = lx - i;
+          amrex::Real yint = ly - j;
+          amrex::Real zint = lz - k;
+
+          amrex::Real sx[] = {1.-xint, xint};
+          amrex::Real sy[] = {1.-yint, yint};
+          amrex::Real sz[] = {1.-zint, zint};
+
+          const amrex::Real mass = ptd.m_rdata[0][ip];
+          for (int kk = 0; kk <= 1; ++kk) {
+              for (int jj = 0; jj <= 1; ++jj) {
+                  for (int ii = 0; ii <= 1; ++ii) {
+                      amrex::Gpu::Atomic::AddNoRet(&rho(i+ii-1, j+jj-1, k+kk-1, 0),
+                                              sx[ii]*sy[jj]*sz[kk]*mass);
+                  }
+              }
+          }
+
+          for (int comp=1; comp < nc; ++comp) {
+             const amrex::Real w = mass*ptd.m_rdata[comp][ip];
+             for (int kk = 0; kk <= 1; ++kk) {
+                  for (int jj = 0; jj <= 1; ++jj) {
+                      for (int ii = 0; ii <= 1; ++ii) {
+                          amrex::Gpu::Atomic::AddNoRet(&rho(i+ii-1, j+jj-1, k+kk-1, comp),
+                                                  sx[ii]*sy[jj]*sz[kk]*w);
+                      }
+                  }
+              }
+          }
+      });
+}
+
+template <class PC, typename std::enable_if<PC::NStructReal == 0, int>::type = 0>
+void interpolateCIC (PC& myPC, const MultiFab& acceleration, const Geometry& geom)
+{
+  using MySoATileData = typename PC::ParticleTileType::ParticleTileDataType;
+  int nc = BL_SPACEDIM;
+  const auto plo = geom.ProbLoArray();
+  const auto dxi = geom.InvCellSizeArray();
+  amrex::MeshToParticle(myPC, acceleration, 0,
+      [=] AMREX_GPU_DEVICE (const MySoATileData& ptd, int ip,
+                            amrex::Array4<const amrex::Real> const& acc)
+      {
+          amrex::Real lx = (ptd.pos(0,ip) - plo[0]) * dxi[0] + 0.5;
+          amrex::Real ly = (ptd.pos(1,ip) - plo[1]) * dxi[1] + 0.5;
+          amrex::Real lz = (ptd.pos(2,ip) - plo[2]) * dxi[2] + 0.5;
+
+          int i = amrex::Math::floor(lx);
+          int j = amrex::Math::floor(ly);
+          int k = amrex::Math::floor(lz);
+
+          amrex::Real xint = lx - i;
+          amrex::Real yint = ly - j;
+          amrex::Real zint = lz - k;
+
+          amrex::Real sx[] = {1.-xint, xint};
+          amrex::Real sy[] = {1.-yint, yint};
+          amrex::Real sz[] = {1.-zint, zint};
+
+          for (int comp=0; comp < nc; ++comp) {
+              amrex::Real a = 0.0;
+              for (int kk = 0; kk <= 1; ++kk) {
+                  for (int jj = 0; jj <= 1; ++jj) {
+                      for (int ii = 0; ii <= 1; ++ii) {
+                          a += sx[ii]*sy[jj]*sz[kk]*acc(i+ii-1,j+jj-1,k+kk-1,comp);
+                      }
+                  }
+              }
+              ptd.m_rdata[4+comp][ip] += a;
+          }
+      });
+}
+
+//
+// Times nrep deposition and interpolation passes.
+//
+template <class PC>
+void timeParticleMesh (PC& myPC, MultiFab& partMF, const MultiFab& acceleration,
+                       const Geometry& geom, int nrep, const std::string& label)
+{
+  Real t0 = amrex::second();
+  for (int irep = 0; irep < nrep; ++irep) {
+      depositCIC(myPC, partMF, geom);
+  }
+  Gpu::streamSynchronize();
+  Real t1 = amrex::second();
+  for (int irep = 0; irep < nrep; ++irep) {
+      interpolateCIC(myPC, acceleration, geom);
+  }
+  Gpu::streamSynchronize();
+  Real t2 = amrex::second();
+
+  ParallelDescriptor::ReduceRealMax(t0);
+  ParallelDescriptor::ReduceRealMax(t1);
+  ParallelDescriptor::ReduceRealMax(t2);
+
+  const Real np = static_cast<Real>(myPC.TotalNumberOfParticles());
+  amrex::Print() << label << ": ParticleToMesh " << nrep*np/(t1-t0)/1.e6
+                 << " Mparticles/s, MeshToParticle " << nrep*np/(t2-t1)/1.e6
+                 << " Mparticles/s\n";
+}
+
+//
+// Checks that Redistribute sorts the particles by cell and keeps the tiles
+// in order as the particles move.  With timing, also compares the
+// throughput of the particle-mesh operations before and after sorting.
+//
+void testSort (MyParticleContainer& myPC, MultiFab& partMF, const MultiFab& acceleration,
+               const Geometry& geom, bool timing)
+{
+  const int nrep = 5;
+  const IntVect bin_size(AMREX_D_DECL(1,1,1));
+  const Long np_total = myPC.TotalNumberOfParticles();
+
+  amrex::Print() << "\nDisorder before sorting       : " << myPC.ParticleDisorder(bin_size) << '\n';
+  if (timing) timeParticleMesh(myPC, partMF, acceleration, geom, nrep, "Unsorted");
+
+  myPC.SetSortBinSize(bin_size);
+  myPC.Redistribute();
+  const Real disorder = myPC.ParticleDisorder(bin_size);
+  amrex::Print() << "Disorder after sorting        : " << disorder << '\n';
+  AMREX_ALWAYS_ASSERT(disorder == 0.0);
+  AMREX_ALWAYS_ASSERT(myPC.TotalNumberOfParticles() == np_total);
+  if (timing) timeParticleMesh(myPC, partMF, acceleration, geom, nrep, "Sorted  ");
+
+  // Move the particles by up to a quarter of a cell, so that only some of
+  // them change cells.
+  const Real dx = geom.CellSize(0);
+  for (int step = 0; step < 4; ++step)
+  {
+      for (MyParIter pti(myPC, 0); pti.isValid(); ++pti)
+      {
+          auto pstruct_ptr = pti.GetArrayOfStructs()().dataPtr();
+          amrex::ParallelForRNG(pti.numParticles(),
+          [=] AMREX_GPU_DEVICE (int i, RandomEngine const& engine) noexcept
+          {
+              for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                  pstruct_ptr[i].pos(idim) += 0.5*dx*(amrex::Random(engine)-0.5);
+              }
+          });
+      }
+      const Real moved = myPC.ParticleDisorder(bin_size);
+      myPC.Redistribute();
+      const Real resorted = myPC.ParticleDisorder(bin_size);
+      amrex::Print() << "Step " << step << " disorder after moving  : " << moved
+                     << ", after Redistribute : " << resorted << '\n';
+      AMREX_ALWAYS_ASSERT(resorted <= myPC.SortDisorderThreshold());
+      AMREX_ALWAYS_ASSERT(myPC.TotalNumberOfParticles() == np_total);
+  }
+  if (timing) timeParticleMesh(myPC, partMF, acceleration, geom, nrep, "Resorted");
+}
+
+//
+// Compares the particle-mesh operations with the attributes in the particle
+// struct and in struct-of-arrays components.  Both containers hold the same
+// particles, so they must deposit the same fields.  With timing, also
+// compares their throughput.
+//
+void testSoA (const Geometry& geom, const BoxArray& ba, const DistributionMapping& dmap,
+              int num_particles, bool timing)
+{
+  const int nrep = 5;
+  const int iseed = 451;
+  const Real mass = 10.0;
+
+  MyParticleContainer aosPC(geom, dmap, ba);
+  MyParticleContainer::ParticleInitData aos_data = {{mass, AMREX_D_DECL(1.0, 2.0, 3.0), AMREX_D_DECL(0.0, 0.0, 0.0)},
+                                                    {}, {}, {}};
+  aosPC.InitRandom(num_particles, iseed, aos_data, true);
+
+  MySoAParticleContainer soaPC(geom, dmap, ba);
+  MySoAParticleContainer::ParticleInitData soa_data = {{}, {},
+                                                       {mass, AMREX_D_DECL(1.0, 2.0, 3.0), AMREX_D_DECL(0.0, 0.0, 0.0)},
+                                                       {}};
+  soaPC.InitRandom(num_particles, iseed, soa_data, true);
+
+  MultiFab aosMF(ba, dmap, 1 + BL_SPACEDIM, 1);
+  MultiFab soaMF(ba, dmap, 1 + BL_SPACEDIM, 1);
+  depositCIC(aosPC, aosMF, geom);
+  depositCIC(soaPC, soaMF, geom);
+  for (int comp = 0; comp < aosMF.nComp(); ++comp) {
+      const Real scale = amrex::max(aosMF.norm0(comp), 1.0_rt);
+      MultiFab::Subtract(soaMF, aosMF, comp, comp, 1, 0);
+      AMREX_ALWAYS_ASSERT(soaMF.norm0(comp) <= 1.e-12*scale);
+  }
+
+  MultiFab acceleration(ba, dmap, BL_SPACEDIM, 1);
+  acceleration.setVal(5.0);
+
+  // Sort by cell so that the mesh accesses are local and the time is spent
+  // streaming through the particle data.
+  aosPC.SortParticlesByCell();
+  soaPC.SortParticlesByCell();
+
+  // The same particles again with the positions, ids and cpus as components.
+  MyPureSoAParticleContainer pureSoaPC(geom, dmap, ba);
+  for (MySoAParticleContainer::ParConstIterType pti(soaPC, 0); pti.isValid(); ++pti)
+  {
+      const auto& src = pti.GetParticleTile();
+      const auto ptd = src.getConstParticleTileData();
+      auto& dst = pureSoaPC.DefineAndReturnParticleTile(0, pti.index(), pti.LocalTileIndex());
+      for (int i = 0; i < src.numParticles(); ++i) {
+          dst.push_back(ptd.getSuperParticle(i));
+      }
+  }
+  AMREX_ALWAYS_ASSERT(pureSoaPC.TotalNumberOfParticles() == soaPC.TotalNumberOfParticles());
+
+  if (!timing) return;
+
+  amrex::Print() << "\nParticle struct of " << sizeof(MyParticleContainer::ParticleType)
+                 << " bytes vs " << sizeof(MySoAParticleContainer::ParticleType) << " bytes\n";
+  timeParticleMesh(aosPC, aosMF, acceleration, geom, nrep, "AoS attributes");
+  timeParticleMesh(soaPC, soaMF, acceleration, geom, nrep, "SoA attributes");
+  timeParticleMesh(pureSoaPC, soaMF, acceleration, geom, nrep, "SoA layout    ");
+}
+
+//
+// The same deposition and interpolation with the built-in shape function
+// kernels, with Order 1 for CIC, 2 for TSC and 3 for PCS.
+//
+template <int Order>
+void depositShape (MyParticleContainer& myPC, MultiFab& partMF)
+{
+  amrex::ShapeParticleToMesh<Order>(myPC, partMF, 0,
+      [=] AMREX_GPU_DEVICE (const MyParticleContainer::ParticleType& p, int comp) -> amrex::Real
+      {
+          return (comp == 0) ? p.rdata(0) : p.rdata(0)*p.rdata(comp);
+      });
+}
+
+template <int Order>
+void interpolateShape (MyParticleContainer& myPC, const MultiFab& acceleration, Real sign = 1.0)
+{
+  amrex::ShapeMeshToParticle<Order>(myPC, acceleration, 0,
+      [=] AMREX_GPU_DEVICE (MyParticleContainer::ParticleType& p, int comp, amrex::Real a)
+      {
+          p.rdata(4+comp) += sign*a;
+      });
+}
+
+void setAcceleration (MyParticleContainer& myPC, Real val)
+{
+  for (MyParIter pti(myPC, 0); pti.isValid(); ++pti)
+  {
+      auto pstruct_ptr = pti.GetArrayOfStructs()().dataPtr();
+      amrex::ParallelFor(pti.numParticles(), [=] AMREX_GPU_DEVICE (int i) noexcept
+      {
+          for (int comp = 0; comp < BL_SPACEDIM; ++comp) pstruct_ptr[i].rdata(4+comp) = val;
+      });
+  }
+}
+
+Real maxAccelerationError (MyParticleContainer& myPC, Real val)
+{
+  using PType = MyParticleContainer::SuperParticleType;
+  Real err = amrex::ReduceMax(myPC,
+      [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
+      {
+          Real e = 0.0;
+          for (int comp = 0; comp < BL_SPACEDIM; ++comp) {
+              e = amrex::max(e, std::abs(p.rdata(4+comp) - val));
+          }
+          return e;
+      });
+  ParallelDescriptor::ReduceRealMax(err);
+  return err;
+}
+
+//
+// Checks the shape function kernels against the lambda versions above, and
+// checks that every order conserves the deposited quantities and
+// interpolates a constant field exactly.
+//
+void testShapeFunctions (MyParticleContainer& myPC, const Geometry& geom,
+                         const BoxArray& ba, const DistributionMapping& dmap)
+{
+  const int nc = 1 + BL_SPACEDIM;
+  MultiFab lambdaMF(ba, dmap, nc, 2);
+  MultiFab shapeMF(ba, dmap, nc, 2);
+
+  depositCIC(myPC, lambdaMF, geom);
+  depositShape<1>(myPC, shapeMF);
+  for (int comp = 0; comp < nc; ++comp) {
+      const Real scale = amrex::max(lambdaMF.norm0(comp), 1.0_rt);
+      MultiFab::Subtract(shapeMF, lambdaMF, comp, comp, 1, 0);
+      AMREX_ALWAYS_ASSERT(shapeMF.norm0(comp) <= 1.e-12*scale);
+  }
+
+  const Real total_mass = lambdaMF.sum(0);
+  depositShape<2>(myPC, shapeMF);
+  AMREX_ALWAYS_ASSERT(std::abs(shapeMF.sum(0) - total_mass) <= 1.e-12*total_mass);
+  depositShape<3>(myPC, shapeMF);
+  AMREX_ALWAYS_ASSERT(std::abs(shapeMF.sum(0) - total_mass) <= 1.e-12*total_mass);
+
+  // A smooth periodic field for CIC, where both versions must agree.
+  MultiFab acceleration(ba, dmap, BL_SPACEDIM, 2);
+  const auto dx = geom.CellSizeArray();
+  for (MFIter mfi(acceleration); mfi.isValid(); ++mfi)
+  {
+      const auto acc = acceleration.array(mfi);
+      amrex::ParallelFor(mfi.validbox(), BL_SPACEDIM,
+      [=] AMREX_GPU_DEVICE (int i, int j, int k, int comp) noexcept
+      {
+          amrex::ignore_unused(j,k);
+          acc(i,j,k,comp) = AMREX_D_TERM(std::sin(2.0*M_PI*(i+0.5)*dx[0]),
+                                         * std::cos(2.0*M_PI*(j+0.5)*dx[1]),
+                                         + k*dx[2]) + comp;
+      });
+  }
+  acceleration.FillBoundary(geom.periodicity());
+
+  setAcceleration(myPC, 0.0);
+  interpolateCIC(myPC, acceleration, geom);
+  interpolateShape<1>(myPC, acceleration, -1.0);
+  AMREX_ALWAYS_ASSERT(maxAccelerationError(myPC, 0.0) <= 1.e-12);
+
+  acceleration.setVal(5.0);
+  setAcceleration(myPC, 0.0);
+  interpolateShape<2>(myPC, acceleration);
+  AMREX_ALWAYS_ASSERT(maxAccelerationError(myPC, 5.0) <= 1.e-12);
+  setAcceleration(myPC, 0.0);
+  interpolateShape<3>(myPC, acceleration);
+  AMREX_ALWAYS_ASSERT(maxAccelerationError(myPC, 5.0) <= 1.e-12);
+}
+
+//
+// Times nrep deposition and interpolation passes with the shape function
+// kernels.
+//
+template <int Order>
+void timeShape (MyParticleContainer& myPC, MultiFab& partMF, const MultiFab& acceleration,
+                int nrep, const std::string& label)
+{
+  Real t0 = amrex::second();
+  for (int irep = 0; irep < nrep; ++irep) {
+      depositShape<Order>(myPC, partMF);
+  }
+  Gpu::streamSynchronize();
+  Real t1 = amrex::second();
+  for (int irep = 0; irep < nrep; ++irep) {
+      interpolateShape<Order>(myPC, acceleration);
+  }
+  Gpu::streamSynchronize();
+  Real t2 = amrex::second();
+
+  ParallelDescriptor::ReduceRealMax(t0);
+  ParallelDescriptor::ReduceRealMax(t1);
+  ParallelDescriptor::ReduceRealMax(t2);
+
+  const Real np = static_cast<Real>(myPC.TotalNumberOfParticles());
+  amrex::Print() << label << ": ParticleToMesh " << nrep*np/(t1-t0)/1.e6
+                 << " Mparticles/s, MeshToParticle " << nrep*np/(t2-t1)/1.e6
+                 << " Mparticles/s\n";
+}
+
+void testShapeTiming (MyParticleContainer& myPC, const Geometry& geom,
+                      const BoxArray& ba, const DistributionMapping& dmap)
+{
+  const int nrep = 5;
+  MultiFab partMF(ba, dmap, 1 + BL_SPACEDIM, 2);
+  MultiFab acceleration(ba, dmap, BL_SPACEDIM, 2);
+  acceleration.setVal(5.0);
+
+  myPC.SortParticlesByCell();
+
+  amrex::Print() << '\n';
+  timeParticleMesh(myPC, partMF, acceleration, geom, nrep, "CIC lambda");
+  timeShape<1>(myPC, partMF, acceleration, nrep, "CIC shape ");
+  timeShape<2>(myPC, partMF, acceleration, nrep, "TSC shape ");
+  timeShape<3>(myPC, partMF, acceleration, nrep, "PCS shape ");
+}
+
+void testParticleMesh(TestParams& parms)
+{
+
+  RealBox real_box;
+  for (int n = 0; n < BL_SPACEDIM; n++) {
+    real_box.setLo(n, 0.0);
+    real_box.setHi(n, 1.0);
+  }
+
+  IntVect domain_lo(AMREX_D_DECL(0, 0, 0));
+  IntVect domain_hi(AMREX_D_DECL(parms.nx - 1, parms.ny - 1, parms.nz-1));
+  const Box domain(domain_lo, domain_hi);
+
+  // This sets the boundary conditions to be doubly or triply periodic
+  int is_per[BL_SPACEDIM];
+  for (int i = 0; i < BL_SPACEDIM; i++) 
+    is_per[i] = 1; 
+  Geometry geom(domain, &real_box, CoordSys::cartesian, is_per);
+
+  BoxArray ba(domain);
+  ba.maxSize(parms.max_grid_size);
+  if (parms.verbose && ParallelDescriptor::IOProcessor()) {
+    std::cout << "Number of boxes              : " << ba[0].size() << '\n' << '\n';
+  }
+
+  DistributionMapping dmap(ba);
+
+  MultiFab partMF(ba, dmap, 1 + BL_SPACEDIM, 1);
+  partMF.setVal(0.0);
+
+  MyParticleContainer myPC(geom, dmap, ba);
+  myPC.SetVerbose(false);
+
+  int num_particles = parms.nppc * parms.nx * parms.ny * parms.nz;
+  if (ParallelDescriptor::IOProcessor())
+    std::cout << "Total number of particles    : " << num_particles << '\n' << '\n';
+
+  bool serialize = true;
+  int iseed = 451;
+  Real mass = 10.0;
+
+  MyParticleContainer::ParticleInitData pdata = {mass, AMREX_D_DECL(1.0, 2.0, 3.0), AMREX_D_DECL(0.0, 0.0, 0.0)};
+  myPC.InitRandom(num_particles, iseed, pdata, serialize);
+
+  depositCIC(myPC, partMF, geom);
+
+  MultiFab acceleration(ba, dmap, BL_SPACEDIM, 1);
+  acceleration.setVal(5.0);
+
+  interpolateCIC(myPC, acceleration, geom);
   
   WriteSingleLevelPlotfile("plot", partMF, 
                            {"density", "vx", "vy", "vz"},
                            geom, 0.0, 0);
 
   myPC.Checkpoint("plot", "particle0");
+
+  if (parms.sort_timing) {
+      testSort(myPC, partMF, acceleration, geom, true);
+  }
+
+  if (parms.soa_timing) {
+      testSoA(geom, ba, dmap, num_particles, true);
+  }
+
+  testShapeFunctions(myPC, geom, ba, dmap);
+
+  // With few particles per tile, ShapeParticleToMesh only deposits into the
+  // bounding box of their stencils.
+  MyParticleContainer sparsePC(geom, dmap, ba);
+  sparsePC.SetVerbose(false);
+  sparsePC.InitRandom(std::max(num_particles/64, 1), iseed+1, pdata, serialize);
+  testShapeFunctions(sparsePC, geom, ba, dmap);
+
+  // Without the timing, the sorting and SoA checks run on few particles.
+  testSort(sparsePC, partMF, acceleration, geom, false);
+  testSoA(geom, ba, dmap, std::max(num_particles/64, 1), false);
+
+  if (parms.shape_timing) {
+      testShapeTiming(myPC, geom, ba, dmap);
+  }
 }
 
 int main(int argc, char* argv[])
@@ -167,6 +611,15 @@ int main(int argc, char* argv[])
   
   parms.verbose = false;
   pp.query("verbose", parms.verbose);
+
+  parms.sort_timing = false;
+  pp.query("sort_timing", parms.sort_timing);
+
+  parms.soa_timing = false;
+  pp.query("soa_timing", parms.soa_timing);
+
+  parms.shape_timing = false;
+  pp.query("shape_timing", parms.shape_timing);
   
   if (parms.verbose && ParallelDescriptor::IOProcessor()) {
     std::cout << std::endl;
@@ -0,0 +1,143 @@
+#include <AMReX.H>
+#include <AMReX_DenseBins.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_OpenMP.H>
+#include <AMReX_ParticleUtil.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace amrex;
+
+namespace {
+
+// The permutation std::stable_sort gives for the keys.
+std::vector<unsigned int> stablePermutation (const std::vector<unsigned int>& keys)
+{
+    std::vector<unsigned int> perm(keys.size());
+    std::iota(perm.begin(), perm.end(), 0u);
+    std::stable_sort(perm.begin(), perm.end(), [&] (unsigned int a, unsigned int b)
+                     { return keys[a] < keys[b]; });
+    return perm;
+}
+
+void checkIncremental (const std::vector<unsigned int>& keys)
+{
+    const int n = keys.size();
+    std::vector<unsigned int> perm(n);
+    incrementalSortPermutation(keys.data(), n, perm.data());
+    AMREX_ALWAYS_ASSERT(perm == stablePermutation(keys));
+}
+
+void testIncrementalSortPermutation (int n)
+{
+    checkIncremental({});
+    checkIncremental({7});
+    checkIncremental({5,3,3});
+    checkIncremental({3,3,1,3,3});
+    checkIncremental({4,4,4,4});
+
+    std::mt19937 gen(42);
+
+    // Sorted keys with a few of them displaced, as after a short step.
+    for (unsigned int nkeys : {4u, 64u, 100000u})
+    {
+        std::vector<unsigned int> keys(n);
+        for (int i = 0; i < n; ++i) {
+            keys[i] = static_cast<unsigned int>((static_cast<Long>(i)*nkeys)/n);
+        }
+        std::uniform_int_distribution<int> pick(0, n-1);
+        for (int i = 0; i < n/20; ++i) {
+            std::swap(keys[pick(gen)], keys[pick(gen)]);
+        }
+        checkIncremental(keys);
+    }
+
+    // Random keys with many duplicates.
+    std::uniform_int_distribution<unsigned int> key(0, 15);
+    std::vector<unsigned int> keys(n);
+    for (auto& k : keys) { k = key(gen); }
+    checkIncremental(keys);
+
+    amrex::Print() << "incrementalSortPermutation matches std::stable_sort\n";
+}
+
+void checkDenseBins (const std::vector<unsigned int>& keys, int nbins)
+{
+    const int n = keys.size();
+    Gpu::DeviceVector<unsigned int> items(n);
+    Gpu::copy(Gpu::hostToDevice, keys.begin(), keys.end(), items.begin());
+
+    DenseBins<unsigned int> bins;
+    bins.build(n, items.data(), nbins,
+               [=] AMREX_GPU_DEVICE (unsigned int k) noexcept { return k; });
+
+    std::vector<unsigned int> perm(n), offsets(nbins+1);
+    Gpu::copy(Gpu::deviceToHost, bins.permutationPtr(), bins.permutationPtr()+n, perm.begin());
+    Gpu::copy(Gpu::deviceToHost, bins.offsetsPtr(), bins.offsetsPtr()+nbins+1, offsets.begin());
+
+    for (int b = 0; b <= nbins; ++b) {
+        const auto nbefore = std::count_if(keys.begin(), keys.end(),
+                                           [=] (unsigned int k) { return k < unsigned(b); });
+        AMREX_ALWAYS_ASSERT(offsets[b] == unsigned(nbefore));
+    }
+
+#ifdef AMREX_USE_GPU
+    // The GPU sort is not stable, so only compare the bins.
+    auto bin_of = [&] (std::vector<unsigned int>& p) {
+        for (auto& i : p) { i = keys[i]; }
+    };
+    auto expected = stablePermutation(keys);
+    bin_of(perm);
+    bin_of(expected);
+    AMREX_ALWAYS_ASSERT(perm == expected);
+#else
+    AMREX_ALWAYS_ASSERT(perm == stablePermutation(keys));
+#endif
+}
+
+void testDenseBins (int n)
+{
+    checkDenseBins({}, 4);
+    checkDenseBins({2}, 4);
+    checkDenseBins({3,1,3,0,1,3}, 5);
+
+    std::mt19937 gen(7);
+
+    // Of every three bins, the first is empty, the second holds a single
+    // item and the third holds the rest.  There are enough items per bin
+    // for the counting sort to use all the threads.
+    const int nbins = 300;
+    std::vector<unsigned int> keys;
+    for (int b = 1; b < nbins; b += 3) { keys.push_back(b); }
+    std::uniform_int_distribution<int> full(0, nbins/3-1);
+    while (static_cast<int>(keys.size()) < n) { keys.push_back(3*full(gen)+2); }
+    std::shuffle(keys.begin(), keys.end(), gen);
+    checkDenseBins(keys, nbins);
+
+    // More bins than items.
+    keys.resize(1000);
+    checkDenseBins(keys, nbins*10);
+
+    amrex::Print() << "DenseBins matches std::stable_sort with "
+                   << OpenMP::get_max_threads() << " threads\n";
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int n = 100000;
+        {
+            ParmParse pp("sort");
+            pp.query("n", n);
+        }
+        testIncrementalSortPermutation(n);
+        testDenseBins(n);
+    }
+    amrex::Finalize();
+}
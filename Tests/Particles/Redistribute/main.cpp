@@ -295,6 +295,7 @@ struct TestParams
     int nlevs;
     int do_regrid;
     int sort;
+    int do_load_balance;
 };
 
 void testRedistribute();
@@ -326,6 +327,9 @@ void get_test_params(TestParams& params, const std::string& prefix)
 
     params.sort = 0;
     pp.query("sort", params.sort);
+
+    params.do_load_balance = 0;
+    pp.query("do_load_balance", params.do_load_balance);
 }
 
 void testRedistribute ()
@@ -422,6 +426,68 @@ void testRedistribute ()
             pc.RedistributeGlobal();
             pc.checkAnswer();
         }
+
+        {
+            // Fewer, larger grids.  The tiles of the grids that are gone are
+            // still there when Redistribute runs.
+            for (int lev = 0; lev < params.nlevs; ++lev)
+            {
+                ba[lev] = BoxArray(ba[lev].minimalBox());
+                ba[lev].maxSize(2*params.max_grid_size);
+                dm[lev].define(ba[lev]);
+                pc.SetParticleBoxArray(lev, ba[lev]);
+                pc.SetParticleDistributionMap(lev, dm[lev]);
+            }
+            pc.Redistribute();
+            pc.checkAnswer();
+        }
+    }
+
+    if (params.do_load_balance)
+    {
+        // Put all the boxes on rank 0 and let LoadBalance spread them out again.
+        for (int lev = 0; lev < params.nlevs; ++lev)
+        {
+            Vector<int> pmap(ba[lev].size(), 0);
+            pc.SetParticleDistributionMap(lev, DistributionMapping(pmap));
+        }
+        pc.RedistributeGlobal();
+        pc.checkAnswer();
+
+        pc.SetCostTracking(true);
+        Long np_iter = 0;
+        for (int lev = 0; lev < params.nlevs; ++lev)
+        {
+            AMREX_ALWAYS_ASSERT(pc.MeasuredCosts(lev) != nullptr);
+            for (ParIter<NSR, NSI, NAR, NAI> pti(pc, lev); pti.isValid(); ++pti) {
+                np_iter += pti.numParticles();
+            }
+        }
+        ParallelDescriptor::ReduceLongSum(np_iter);
+        AMREX_ALWAYS_ASSERT(np_iter == pc.TotalNumberOfParticles());
+
+        Vector<Real> eff_before(params.nlevs);
+        for (int lev = 0; lev < params.nlevs; ++lev)
+        {
+            Real eff_proposed;
+            pc.BalancedDistributionMap(lev, eff_before[lev], eff_proposed);
+            amrex::Print() << "Level " << lev << " load balance efficiency before: "
+                           << eff_before[lev] << ", proposed: " << eff_proposed << "\n";
+        }
+
+        pc.LoadBalance();
+        pc.checkAnswer();
+
+        for (int lev = 0; lev < params.nlevs; ++lev)
+        {
+            Real eff_after, eff_proposed;
+            pc.BalancedDistributionMap(lev, eff_after, eff_proposed);
+            amrex::Print() << "Level " << lev << " load balance efficiency after: "
+                           << eff_after << "\n";
+            if (ParallelDescriptor::NProcs() > 1 && ba[lev].size() > 1) {
+                AMREX_ALWAYS_ASSERT(eff_after > eff_before[lev]);
+            }
+        }
     }
 
     if (geom[0].isAllPeriodic()) AMREX_ALWAYS_ASSERT(np_old == pc.TotalNumberOfParticles());
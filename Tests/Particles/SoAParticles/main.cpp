@@ -0,0 +1,277 @@
+#include <AMReX.H>
+#include <AMReX_FileSystem.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Particles.H>
+#include <AMReX_ParticleMesh.H>
+
+#include <algorithm>
+
+using namespace amrex;
+
+struct TestParams {
+    int n_cell;
+    int max_grid_size;
+    int nppc;
+    int nsteps;
+};
+
+// The same particles in the two layouts: NR array reals, the first
+// AMREX_SPACEDIM of which are the velocity, and NI array ints.
+constexpr int NR = AMREX_SPACEDIM + 1;
+constexpr int NI = 1;
+
+using SoAPC = SoAParticleContainer<NR, NI>;
+using AoSPC = ParticleContainer<0, 0, NR, NI>;
+using SuperParticleType = SoAPC::SuperParticleType;
+
+static_assert(std::is_same<SoAPC::SuperParticleType, AoSPC::SuperParticleType>::value,
+              "The two containers must hold the same particles");
+
+// nppc particles in every cell, with velocities of up to a cell per step.
+void addParticles (SoAPC& soa, AoSPC& aos, const Geometry& geom, int nppc)
+{
+    const auto plo = geom.ProbLoArray();
+    const auto dx = geom.CellSizeArray();
+    for (MFIter mfi = soa.MakeMFIter(0); mfi.isValid(); ++mfi)
+    {
+        const Box& tile_box = mfi.tilebox();
+        auto& soa_tile = soa.DefineAndReturnParticleTile(0, mfi);
+        auto& aos_tile = aos.DefineAndReturnParticleTile(0, mfi);
+        for (IntVect iv = tile_box.smallEnd(); iv <= tile_box.bigEnd(); tile_box.next(iv))
+        {
+            for (int n = 0; n < nppc; ++n)
+            {
+                SuperParticleType p;
+                p.id()  = SuperParticleType::NextID();
+                p.cpu() = ParallelDescriptor::MyProc();
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    p.pos(d) = plo[d] + (iv[d] + amrex::Random()) * dx[d];
+                    p.rdata(d) = (2.0*amrex::Random() - 1.0) * dx[d];
+                }
+                p.rdata(AMREX_SPACEDIM) = 1.0 + amrex::Random();
+                p.idata(0) = static_cast<int>(p.id() % 7);
+                soa_tile.push_back(p);
+                aos_tile.push_back(p);
+            }
+        }
+    }
+}
+
+// Written against the tile data only, so the same code runs on both layouts.
+template <class PC>
+void moveParticles (PC& pc, Real fac)
+{
+    for (typename PC::ParIterType pti(pc, 0); pti.isValid(); ++pti)
+    {
+        const auto ptd = pti.GetParticleTile().getParticleTileData();
+        amrex::ParallelFor(pti.numParticles(), [=] AMREX_GPU_DEVICE (int i) noexcept
+        {
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                ptd.pos(d, i) += fac * ptd.rdata(d)[i];
+            }
+        });
+    }
+}
+
+template <class PC>
+void invalidateParticles (PC& pc, int every)
+{
+    for (typename PC::ParIterType pti(pc, 0); pti.isValid(); ++pti)
+    {
+        const auto ptd = pti.GetParticleTile().getParticleTileData();
+        amrex::ParallelFor(pti.numParticles(), [=] AMREX_GPU_DEVICE (int i) noexcept
+        {
+            if (ptd.id(i) % every == 0) ptd.id(i) = -ptd.id(i);
+        });
+    }
+}
+
+template <class PC>
+void depositCIC (PC const& pc, MultiFab& mf, const Geometry& geom)
+{
+    const auto plo = geom.ProbLoArray();
+    const auto dxi = geom.InvCellSizeArray();
+    mf.setVal(0.0);
+    amrex::ParticleToMesh(pc, mf, 0,
+        [=] AMREX_GPU_DEVICE (const typename PC::ParticleTileType::ConstParticleTileDataType& ptd,
+                              int ip, amrex::Array4<amrex::Real> const& rho)
+        {
+            int iv[3] = {0, 0, 0};
+            Real s[3][2] = {{1.0, 0.0}, {1.0, 0.0}, {1.0, 0.0}};
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                const Real l = (ptd.pos(d, ip) - plo[d]) * dxi[d] - 0.5;
+                iv[d] = static_cast<int>(amrex::Math::floor(l));
+                s[d][1] = l - iv[d];
+                s[d][0] = 1.0 - s[d][1];
+            }
+            const Real w = ptd.rdata(AMREX_SPACEDIM)[ip];
+            for (int kk = 0; kk <= AMREX_D_PICK(0,0,1); ++kk) {
+                for (int jj = 0; jj <= AMREX_D_PICK(0,1,1); ++jj) {
+                    for (int ii = 0; ii <= 1; ++ii) {
+                        amrex::Gpu::Atomic::AddNoRet(&rho(iv[0]+ii, iv[1]+jj, iv[2]+kk),
+                                                     s[0][ii]*s[1][jj]*s[2][kk]*w);
+                    }
+                }
+            }
+        });
+}
+
+// The particles on this rank, sorted by (cpu, id). Ids are only unique
+// per cpu.
+template <class PC>
+Vector<SuperParticleType> localParticles (PC const& pc)
+{
+    Vector<SuperParticleType> r;
+    for (typename PC::ParConstIterType pti(pc, 0); pti.isValid(); ++pti)
+    {
+        const auto& tile = pti.GetParticleTile();
+        const auto ptd = tile.getConstParticleTileData();
+        for (int i = 0; i < tile.numParticles(); ++i) {
+            r.push_back(ptd.getSuperParticle(i));
+        }
+    }
+    std::sort(r.begin(), r.end(), [] (SuperParticleType const& a, SuperParticleType const& b)
+    {
+        return std::make_pair(int(a.cpu()), Long(a.id())) <
+               std::make_pair(int(b.cpu()), Long(b.id()));
+    });
+    return r;
+}
+
+template <class PCA, class PCB>
+void checkSameParticles (PCA const& a, PCB const& b, const std::string& what)
+{
+    AMREX_ALWAYS_ASSERT(a.TotalNumberOfParticles() == b.TotalNumberOfParticles());
+    AMREX_ALWAYS_ASSERT(a.OK() && b.OK());
+    const auto pa = localParticles(a);
+    const auto pb = localParticles(b);
+    AMREX_ALWAYS_ASSERT(pa.size() == pb.size());
+    for (int i = 0; i < pa.size(); ++i)
+    {
+        AMREX_ALWAYS_ASSERT(pa[i].id() > 0 && pa[i].id() == pb[i].id());
+        AMREX_ALWAYS_ASSERT(pa[i].cpu() == pb[i].cpu());
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            AMREX_ALWAYS_ASSERT(pa[i].pos(d) == pb[i].pos(d));
+        }
+        for (int n = 0; n < NR; ++n) {
+            AMREX_ALWAYS_ASSERT(pa[i].rdata(n) == pb[i].rdata(n));
+        }
+        for (int n = 0; n < NI; ++n) {
+            AMREX_ALWAYS_ASSERT(pa[i].idata(n) == pb[i].idata(n));
+        }
+    }
+    amrex::Print() << what << ": " << a.TotalNumberOfParticles() << " particles match\n";
+}
+
+void testSoAParticles (const TestParams& parms)
+{
+    RealBox real_box;
+    for (int n = 0; n < AMREX_SPACEDIM; n++)
+    {
+        real_box.setLo(n, 0.0);
+        real_box.setHi(n, 1.0);
+    }
+
+    const Box domain(IntVect(AMREX_D_DECL(0,0,0)), IntVect(parms.n_cell-1));
+    int is_per[AMREX_SPACEDIM];
+    for (int i = 0; i < AMREX_SPACEDIM; i++) is_per[i] = 1;
+    Geometry geom(domain, &real_box, CoordSys::cartesian, is_per);
+
+    BoxArray ba(domain);
+    ba.maxSize(parms.max_grid_size);
+    DistributionMapping dm(ba);
+
+    SoAPC soa(geom, dm, ba);
+    AoSPC aos(geom, dm, ba);
+    addParticles(soa, aos, geom, parms.nppc);
+    soa.Redistribute();
+    aos.Redistribute();
+    checkSameParticles(soa, aos, "Init");
+
+    // Local Redistribute after each small step, global after a large one.
+    for (int step = 0; step < parms.nsteps; ++step)
+    {
+        moveParticles(soa, 1.0);
+        moveParticles(aos, 1.0);
+        soa.Redistribute(0, -1, 0, 1);
+        aos.Redistribute(0, -1, 0, 1);
+    }
+    checkSameParticles(soa, aos, "Local Redistribute");
+
+    moveParticles(soa, 0.5*parms.n_cell);
+    moveParticles(aos, 0.5*parms.n_cell);
+    invalidateParticles(soa, 5);
+    invalidateParticles(aos, 5);
+    soa.Redistribute();
+    aos.Redistribute();
+    checkSameParticles(soa, aos, "Global Redistribute");
+
+    // Sorting keeps the particles and leaves them in cell order.
+    soa.SortParticlesByCell();
+    AMREX_ALWAYS_ASSERT(soa.ParticleDisorder(IntVect(1)) == 0.0);
+    checkSameParticles(soa, aos, "SortParticlesByCell");
+
+    MultiFab soa_rho(ba, dm, 1, 1);
+    MultiFab aos_rho(ba, dm, 1, 1);
+    depositCIC(soa, soa_rho, geom);
+    depositCIC(aos, aos_rho, geom);
+    const Real total = aos_rho.sum();
+    MultiFab::Subtract(soa_rho, aos_rho, 0, 0, 1, 0);
+    AMREX_ALWAYS_ASSERT(soa_rho.norm0() <= 1.e-12*total);
+    amrex::Print() << "ParticleToMesh: the deposits match\n";
+
+    // Checkpoints can be read back into either layout.
+    soa.Checkpoint("soa_chk", "particle0");
+    aos.Checkpoint("aos_chk", "particle0");
+    {
+        SoAPC soa2(geom, dm, ba);
+        soa2.Restart("soa_chk", "particle0");
+        checkSameParticles(soa2, aos, "SoA checkpoint to SoA");
+        AoSPC aos2(geom, dm, ba);
+        aos2.Restart("soa_chk", "particle0");
+        checkSameParticles(aos2, aos, "SoA checkpoint to AoS");
+        SoAPC soa3(geom, dm, ba);
+        soa3.Restart("aos_chk", "particle0");
+        checkSameParticles(soa3, aos, "AoS checkpoint to SoA");
+    }
+
+    soa.WritePlotFile("soa_plt", "particle0");
+    ParallelDescriptor::Barrier();
+    if (ParallelDescriptor::IOProcessor()) {
+        AMREX_ALWAYS_ASSERT(FileSystem::Exists("soa_plt/particle0/Header"));
+        FileSystem::RemoveAll("soa_chk");
+        FileSystem::RemoveAll("aos_chk");
+        FileSystem::RemoveAll("soa_plt");
+    }
+
+    // Regrid to fewer, larger grids.  The tiles of the grids that are gone
+    // are still there when Redistribute runs.
+    BoxArray ba2(domain);
+    ba2.maxSize(2*parms.max_grid_size);
+    DistributionMapping dm2(ba2);
+    soa.SetParticleBoxArray(0, ba2);
+    soa.SetParticleDistributionMap(0, dm2);
+    aos.SetParticleBoxArray(0, ba2);
+    aos.SetParticleDistributionMap(0, dm2);
+    soa.Redistribute();
+    aos.Redistribute();
+    checkSameParticles(soa, aos, "Regrid to fewer grids");
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        ParmParse pp;
+
+        TestParams parms;
+        pp.get("n_cell", parms.n_cell);
+        pp.get("max_grid_size", parms.max_grid_size);
+        pp.get("nppc", parms.nppc);
+        pp.get("nsteps", parms.nsteps);
+
+        testSoAParticles(parms);
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,155 @@
+#include <AMReX.H>
+#include <AMReX_AsyncOut.H>
+#include <AMReX_FileSystem.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_TracerParticles.H>
+
+using namespace amrex;
+
+struct TestParams {
+    int n_cell;
+    int max_grid_size;
+    int nsteps;
+    int ncomp;
+};
+
+void test_timestamp (const TestParams& parms)
+{
+    RealBox real_box;
+    for (int n = 0; n < AMREX_SPACEDIM; n++)
+    {
+        real_box.setLo(n, 0.0);
+        real_box.setHi(n, 1.0);
+    }
+
+    const Box domain(IntVect(AMREX_D_DECL(0,0,0)), IntVect(parms.n_cell-1));
+    int is_per[AMREX_SPACEDIM];
+    for (int i = 0; i < AMREX_SPACEDIM; i++) is_per[i] = 1;
+    Geometry geom(domain, &real_box, CoordSys::cartesian, is_per);
+
+    BoxArray ba(domain);
+    ba.maxSize(parms.max_grid_size);
+    DistributionMapping dm(ba);
+
+    MultiFab mf(ba, dm, parms.ncomp, 1);
+    for (int n = 0; n < parms.ncomp; ++n) {
+        mf.setVal(n+1, n, 1, 1);
+    }
+
+    // One tracer per cell, each with its own velocity.
+    TracerParticleContainer pc(geom, dm, ba);
+    const auto dx = geom.CellSizeArray();
+    for (MFIter mfi = pc.MakeMFIter(0); mfi.isValid(); ++mfi)
+    {
+        const Box& tile_box = mfi.tilebox();
+        auto& particles = pc.GetParticles(0)[std::make_pair(mfi.index(), mfi.LocalTileIndex())];
+        for (IntVect iv = tile_box.smallEnd(); iv <= tile_box.bigEnd(); tile_box.next(iv))
+        {
+            TracerParticleContainer::ParticleType p;
+            p.id()  = TracerParticleContainer::ParticleType::NextID();
+            p.cpu() = ParallelDescriptor::MyProc();
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                p.pos(d)   = (iv[d] + 0.5) * dx[d];
+                p.rdata(d) = (d + 1) * amrex::Random();
+            }
+            particles.push_back(p);
+        }
+    }
+
+    // Start from empty time series.
+    if (ParallelDescriptor::IOProcessor())
+    {
+        FileSystem::RemoveAll("timestamp_ascii");
+        FileSystem::RemoveAll("timestamp_binary");
+        amrex::UtilCreateDirectory("timestamp_ascii", 0755);
+    }
+    ParallelDescriptor::Barrier();
+
+    const Real dt = 0.5 * dx[0];
+    Real t_ascii = 0.0, t_binary = 0.0;
+
+    for (int step = 0; step < parms.nsteps; ++step)
+    {
+        for (MFIter mfi = pc.MakeMFIter(0); mfi.isValid(); ++mfi)
+        {
+            auto& aos = pc.GetParticles(0)[std::make_pair(mfi.index(), mfi.LocalTileIndex())].GetArrayOfStructs();
+            for (auto& p : aos) {
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) p.pos(d) += dt * p.rdata(d);
+            }
+        }
+        pc.Redistribute();
+
+        const Real time = (step+1) * dt;
+        std::vector<int> idx(parms.ncomp);
+        for (int n = 0; n < parms.ncomp; ++n) idx[n] = n;
+
+        Real t0 = amrex::second();
+        pc.Timestamp("timestamp_ascii/ts", mf, 0, time, idx);
+        Real t1 = amrex::second();
+        pc.TimestampBinary("timestamp_binary", mf, 0, time, idx);
+        Real t2 = amrex::second();
+
+        t_ascii  += t1 - t0;
+        t_binary += t2 - t1;
+    }
+
+    Real t0 = amrex::second();
+    pc.FlushTimestamps();
+    AMREX_ALWAYS_ASSERT(!pc.hasPendingTimestamps());
+    if (AsyncOut::UseAsyncOut()) AsyncOut::Finish();
+    t_binary += amrex::second() - t0;
+    ParallelDescriptor::Barrier();
+
+    ParallelDescriptor::ReduceRealMax(t_ascii);
+    ParallelDescriptor::ReduceRealMax(t_binary);
+    amrex::Print() << "Timestamp:       " << t_ascii  << " s\n"
+                   << "TimestampBinary: " << t_binary << " s\n";
+
+    //
+    // The history of a particle must hold one sample per step, and the
+    // last one must be where the particle is now.
+    //
+    const int nreals = 1 + 2*AMREX_SPACEDIM + parms.ncomp;
+    int nchecked = 0;
+    for (MFIter mfi = pc.MakeMFIter(0); mfi.isValid() && nchecked < 8; ++mfi)
+    {
+        const auto& aos = pc.GetParticles(0)[std::make_pair(mfi.index(), mfi.LocalTileIndex())].GetArrayOfStructs();
+        for (int i = 0; i < aos.numParticles() && nchecked < 8; i += 7, ++nchecked)
+        {
+            const auto& p = aos[i];
+            auto h = TracerParticleContainer::ReadTimestampHistory("timestamp_binary", p.id(), p.cpu());
+            AMREX_ALWAYS_ASSERT(static_cast<int>(h.size()) == parms.nsteps * nreals);
+
+            for (int s = 0; s < parms.nsteps; ++s) {
+                AMREX_ALWAYS_ASSERT(h[s*nreals] == (s+1) * dt);
+                for (int n = 0; n < parms.ncomp; ++n) {
+                    AMREX_ALWAYS_ASSERT(std::abs(h[s*nreals + 1 + 2*AMREX_SPACEDIM + n] - (n+1)) < 1.e-12);
+                }
+            }
+
+            const Real* last = h.data() + (parms.nsteps-1)*nreals;
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                AMREX_ALWAYS_ASSERT(last[1+d] == p.pos(d));
+                AMREX_ALWAYS_ASSERT(last[1+AMREX_SPACEDIM+d] == p.rdata(d));
+            }
+        }
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        ParmParse pp("timestamp");
+
+        TestParams parms;
+        pp.get("n_cell", parms.n_cell);
+        pp.get("max_grid_size", parms.max_grid_size);
+        pp.get("nsteps", parms.nsteps);
+        pp.get("ncomp", parms.ncomp);
+
+        test_timestamp(parms);
+    }
+    amrex::Finalize();
+}
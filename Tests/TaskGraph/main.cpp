@@ -0,0 +1,353 @@
+
+#include <AMReX.H>
+#include <AMReX_Print.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_iMultiFab.H>
+#include <AMReX_MultiFabUtil.H>
+#include <AMReX_FluxRegister.H>
+#include <AMReX_TaskGraph.H>
+#include <AMReX_Utility.H>
+
+using namespace amrex;
+
+namespace {
+
+constexpr int ncycle = 2;
+
+// Explicit diffusion with subcycling and refluxing on two levels.
+struct TwoLevels
+{
+    Geometry geom[2];
+    BoxArray ba[2];
+    DistributionMapping dm[2];
+    Real dt[2];
+
+    MultiFab phi0[2];                            // coarse old/new, alternating
+    MultiFab phi1[2];                            // fine old/new, alternating
+    Array<MultiFab,AMREX_SPACEDIM> flux0;
+    Array<MultiFab,AMREX_SPACEDIM> flux1[ncycle];
+    MultiFab cfo, cfn;                           // coarse data around the fine boxes
+    iMultiFab fmask;                             // 1 on fine ghost cells covered by fine valid cells
+    std::unique_ptr<FluxRegister> fr;
+
+    //! Uses the DistributionMappings of other if it is given.
+    TwoLevels (int n_cell, int max_grid_size, const TwoLevels* other = nullptr);
+
+    void init ();
+
+    //! Updates box li of phi from iold to inew.  The fluxes times dt and area go to flux.
+    void update (int lev, int iold, int inew, Array<MultiFab,AMREX_SPACEDIM>& flux, int li);
+
+    //! Fills the ghost cells of fine box li not covered by fine boxes from the coarse level.
+    void fillCrseFine (int iold, int substep, int li);
+
+    void stepBulkSynchronous (int step);
+    void stepTaskGraph (int step);
+
+    Real total (int step) const;
+};
+
+TwoLevels::TwoLevels (int n_cell, int max_grid_size, const TwoLevels* other)
+{
+    const Box domain(IntVect(0), IntVect(n_cell-1));
+    RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,1,1)};
+    geom[0].define(domain, rb, CoordSys::cartesian, is_periodic);
+    geom[1].define(amrex::refine(domain,2), rb, CoordSys::cartesian, is_periodic);
+
+    ba[0].define(domain);
+    ba[0].maxSize(max_grid_size);
+    ba[1].define(amrex::refine(amrex::grow(domain, -n_cell/4), 2));
+    ba[1].maxSize(max_grid_size);
+
+    for (int lev = 0; lev < 2; ++lev) {
+        if (other) {
+            dm[lev] = other->dm[lev];
+        } else {
+            dm[lev].define(ba[lev]);
+        }
+        const Real dx = geom[lev].CellSize(0);
+        dt[lev] = 0.2*dx*dx/AMREX_SPACEDIM;
+    }
+    for (int i = 0; i < 2; ++i) {
+        phi0[i].define(ba[0], dm[0], 1, 1);
+        phi1[i].define(ba[1], dm[1], 1, 1);
+    }
+
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        flux0[idim].define(amrex::convert(ba[0], IntVect::TheDimensionVector(idim)), dm[0], 1, 0);
+        for (int k = 0; k < ncycle; ++k) {
+            flux1[k][idim].define(amrex::convert(ba[1], IntVect::TheDimensionVector(idim)), dm[1], 1, 0);
+        }
+    }
+
+    const BoxArray& cba = amrex::coarsen(ba[1], 2);
+    cfo.define(cba, dm[1], 1, 1);
+    cfn.define(cba, dm[1], 1, 1);
+
+    fmask.define(ba[1], dm[1], 1, 1);
+    fmask.setVal(0);
+    fmask.setVal(1, 0, 1, 0);
+    fmask.FillBoundary();
+
+    fr.reset(new FluxRegister(ba[1], dm[1], IntVect(2), 1, 1));
+}
+
+void TwoLevels::init ()
+{
+    for (int lev = 0; lev < 2; ++lev) {
+        MultiFab& mf = (lev == 0) ? phi0[0] : phi1[0];
+        const auto dx = geom[lev].CellSizeArray();
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            auto const& a = mf.array(mfi);
+            amrex::ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                amrex::ignore_unused(j,k);
+                Real r2 = AMREX_D_TERM( ((i+0.5)*dx[0]-0.5)*((i+0.5)*dx[0]-0.5),
+                                      + ((j+0.5)*dx[1]-0.5)*((j+0.5)*dx[1]-0.5),
+                                      + ((k+0.5)*dx[2]-0.5)*((k+0.5)*dx[2]-0.5));
+                a(i,j,k) = std::exp(-20.*r2);
+            });
+        }
+    }
+    amrex::average_down(phi1[0], phi0[0], 0, 1, 2);
+}
+
+void TwoLevels::update (int lev, int iold, int inew, Array<MultiFab,AMREX_SPACEDIM>& flux, int li)
+{
+    MultiFab& mfo = (lev == 0) ? phi0[iold] : phi1[iold];
+    MultiFab& mfn = (lev == 0) ? phi0[inew] : phi1[inew];
+    const Box& bx = mfo.box(mfo.IndexArray()[li]);
+    const Real dx = geom[lev].CellSize(0);
+    const Real area = std::pow(dx, AMREX_SPACEDIM-1);
+    const Real vol = area*dx;
+    const Real fac = dt[lev]*area/dx;
+
+    auto const& po = mfo.atLocalIdx(li).const_array();
+    auto const& pn = mfn.atLocalIdx(li).array();
+    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        pn(i,j,k) = po(i,j,k);
+    });
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        const IntVect e = IntVect::TheDimensionVector(idim);
+        auto const& f = flux[idim].atLocalIdx(li).array();
+        amrex::ParallelFor(amrex::surroundingNodes(bx,idim),
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            const IntVect iv(AMREX_D_DECL(i,j,k));
+            f(iv) = -fac*(po(iv)-po(iv-e));
+        });
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            const IntVect iv(AMREX_D_DECL(i,j,k));
+            pn(iv) -= (f(iv+e)-f(iv))/vol;
+        });
+    }
+}
+
+void TwoLevels::fillCrseFine (int iold, int substep, int li)
+{
+    const Real a = Real(substep)/ncycle;
+    auto const& p = phi1[iold].atLocalIdx(li).array();
+    auto const& m = fmask.atLocalIdx(li).const_array();
+    auto const& co = cfo.atLocalIdx(li).const_array();
+    auto const& cn = cfn.atLocalIdx(li).const_array();
+    amrex::ParallelFor(phi1[iold].atLocalIdx(li).box(),
+    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        const IntVect iv(AMREX_D_DECL(i,j,k));
+        if (m(iv) == 0) {
+            const IntVect civ = amrex::coarsen(iv, 2);
+            p(iv) = (1.-a)*co(civ) + a*cn(civ);
+        }
+    });
+}
+
+void TwoLevels::stepBulkSynchronous (int step)
+{
+    const int o0 = step%2, n0 = 1-o0;
+    const int nlocal0 = phi0[0].local_size();
+    const int nlocal1 = phi1[0].local_size();
+
+    phi0[o0].FillBoundary(geom[0].periodicity());
+    for (int li = 0; li < nlocal0; ++li) {
+        update(0, o0, n0, flux0, li);
+    }
+    fr->setVal(0.0);
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        fr->CrseInit(flux0[idim], idim, 0, 0, 1, -1.0);
+    }
+
+    cfo.ParallelCopy(phi0[o0], 0, 0, 1, IntVect(0), IntVect(1), geom[0].periodicity());
+    cfn.ParallelCopy(phi0[n0], 0, 0, 1, IntVect(0), IntVect(1), geom[0].periodicity());
+
+    for (int k = 0; k < ncycle; ++k) {
+        const int o1 = k%2, n1 = 1-o1;
+        phi1[o1].FillBoundary();
+        for (int li = 0; li < nlocal1; ++li) {
+            fillCrseFine(o1, k, li);
+            update(1, o1, n1, flux1[k], li);
+        }
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            fr->FineAdd(flux1[k][idim], idim, 0, 0, 1, 1.0);
+        }
+    }
+
+    fr->Reflux(phi0[n0], 1.0, 0, 0, 1, geom[0]);
+    amrex::average_down(phi1[ncycle%2], phi0[n0], 0, 1, 2);
+}
+
+// The same step as a task graph.  A box is updated as soon as its own ghost
+// cells have arrived, and the flux register work of the coarse level and of
+// the first substep overlaps the fine updates.
+void TwoLevels::stepTaskGraph (int step)
+{
+    const int o0 = step%2, n0 = 1-o0;
+    const int nlocal0 = phi0[0].local_size();
+    const int nlocal1 = phi1[0].local_size();
+
+    TaskGraph graph;
+
+    FabArrayCommGroup<FArrayBox> fb0, cf, fb1[ncycle];
+    fb0.addFillBoundary(phi0[o0], geom[0].periodicity());
+    cf.addParallelCopy(cfo, phi0[o0], 0, 0, 1, IntVect(0), IntVect(1), geom[0].periodicity());
+    cf.addParallelCopy(cfn, phi0[n0], 0, 0, 1, IntVect(0), IntVect(1), geom[0].periodicity());
+    for (int k = 0; k < ncycle; ++k) {
+        fb1[k].addFillBoundary(phi1[k%2]);
+    }
+
+    // Done when op iop of g has filled box li.
+    auto arrived = [] (FabArrayCommGroup<FArrayBox>& g, int iop, int li) {
+        return [&g,iop,li] () -> bool {
+            if (!g.isReady(iop,li)) g.test();
+            return g.isReady(iop,li);
+        };
+    };
+
+    // Coarse level
+    const auto start0 = graph.addMaster([&] () { fb0.nowait(); });
+    Vector<TaskGraph::Task> upd0;
+    for (int li = 0; li < nlocal0; ++li) {
+        const auto ghosts = graph.addPoll(arrived(fb0, 0, li), {start0});
+        upd0.push_back(graph.add([=] () { update(0, o0, n0, flux0, li); }, {ghosts}));
+    }
+    const auto finish0 = graph.addMaster([&] () { fb0.finish(); }, upd0);
+    const auto crseinit = graph.addMaster([&] () {
+        fr->setVal(0.0);
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            fr->CrseInit(flux0[idim], idim, 0, 0, 1, -1.0);
+        }
+    }, upd0);
+
+    // Fine level
+    const auto startcf = graph.addMaster([&] () { cf.nowait(); }, upd0);
+    TaskGraph::Task prev_finish = finish0;
+    Vector<TaskGraph::Task> fineadd;
+    Vector<TaskGraph::Task> upd1;
+    for (int k = 0; k < ncycle; ++k) {
+        const int o1 = k%2, n1 = 1-o1;
+        const auto start1 = graph.addMaster([&fb1,k] () { fb1[k].nowait(); }, {prev_finish, startcf});
+        Vector<TaskGraph::Task> upd1k;
+        for (int li = 0; li < nlocal1; ++li) {
+            Vector<TaskGraph::Task> deps{graph.addPoll(arrived(fb1[k], 0, li), {start1})};
+            if (k == 0) {
+                deps.push_back(graph.addPoll(arrived(cf, 0, li), {startcf}));
+                deps.push_back(graph.addPoll(arrived(cf, 1, li), {startcf}));
+            } else {
+                deps.push_back(upd1[li]);
+            }
+            upd1k.push_back(graph.add([=] () {
+                fillCrseFine(o1, k, li);
+                update(1, o1, n1, flux1[k], li);
+            }, deps));
+        }
+        upd1 = upd1k;
+        prev_finish = graph.addMaster([&fb1,k] () { fb1[k].finish(); }, upd1k);
+        Vector<TaskGraph::Task> deps = upd1k;
+        deps.push_back(crseinit);
+        if (!fineadd.empty()) deps.push_back(fineadd.back());
+        fineadd.push_back(graph.addMaster([this,k] () {
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                fr->FineAdd(flux1[k][idim], idim, 0, 0, 1, 1.0);
+            }
+        }, deps));
+    }
+    const auto finishcf = graph.addMaster([&] () { cf.finish(); }, upd1);
+
+    graph.addMaster([&] () {
+        fr->Reflux(phi0[n0], 1.0, 0, 0, 1, geom[0]);
+        amrex::average_down(phi1[ncycle%2], phi0[n0], 0, 1, 2);
+    }, {fineadd.back(), prev_finish, finishcf});
+
+    graph.run();
+}
+
+Real TwoLevels::total (int step) const
+{
+    return phi0[step%2].sum() * AMREX_D_TERM(geom[0].CellSize(0),*geom[0].CellSize(1),*geom[0].CellSize(2));
+}
+
+}
+
+void test ();
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    test();
+    amrex::Finalize();
+}
+
+// Times subcycled steps on two levels done in bulk-synchronous order and as
+// a task graph, and checks that they agree exactly and conserve the total.
+void test ()
+{
+    int n_cell = 64;
+    int max_grid_size = 16;
+    int nsteps = 10;
+    {
+        ParmParse pp;
+        pp.query("n_cell", n_cell);
+        pp.query("max_grid_size", max_grid_size);
+        pp.query("nsteps", nsteps);
+    }
+
+    TwoLevels bs(n_cell, max_grid_size);
+    TwoLevels tg(n_cell, max_grid_size, &bs);
+    bs.init();
+    tg.init();
+    const Real total0 = bs.total(0);
+
+    ParallelDescriptor::Barrier();
+    Real t0 = amrex::second();
+    for (int step = 0; step < nsteps; ++step) {
+        bs.stepBulkSynchronous(step);
+    }
+    ParallelDescriptor::Barrier();
+    const Real t_bs = amrex::second() - t0;
+
+    t0 = amrex::second();
+    for (int step = 0; step < nsteps; ++step) {
+        tg.stepTaskGraph(step);
+    }
+    ParallelDescriptor::Barrier();
+    const Real t_tg = amrex::second() - t0;
+
+    const int n = nsteps%2;
+    MultiFab::Subtract(tg.phi0[n], bs.phi0[n], 0, 0, 1, 0);
+    MultiFab::Subtract(tg.phi1[0], bs.phi1[0], 0, 0, 1, 0);
+    const Real diff = std::max(tg.phi0[n].norm0(), tg.phi1[0].norm0());
+    const Real change = (bs.total(nsteps)-total0)/total0;
+
+    amrex::Print() << bs.ba[0].size() << " coarse and " << bs.ba[1].size() << " fine boxes, "
+                   << nsteps << " coarse steps\n"
+                   << "    bulk synchronous " << t_bs << " s, task graph " << t_tg
+                   << " s, max difference " << diff << "\n"
+                   << "    relative change of the total " << change << "\n";
+
+    // The task graph does the same operations on each box in the same order.
+    AMREX_ALWAYS_ASSERT(diff == 0.0);
+    AMREX_ALWAYS_ASSERT(std::abs(change) < 1.e-12);
+}
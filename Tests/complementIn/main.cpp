@@ -3,24 +3,34 @@
 #include <AMReX_Print.H>
 #include <AMReX_BoxList.H>
 #include <AMReX_BoxArray.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Random.H>
+#include <AMReX_Utility.H>
 #include <fstream>
 
 using namespace amrex;
 
-void test ();
+void test (int ngrids);
+void scaling ();
 BoxArray readBoxList (const std::string& file, Box& domain);
+BoxArray makeClusteredBoxes (const Box& domain, int box_size, int nboxes);
 
 int main(int argc, char* argv[])
 {
     amrex::Initialize(argc,argv);
-    test();
+    {
+        ParmParse pp;
+        int nfiles = 10;
+        pp.query("nfiles", nfiles);
+        if (nfiles > 0) test(nfiles);
+        scaling();
+    }
     amrex::Finalize();
 }
 
-void test ()
+void test (int ngrids)
 {
     BL_PROFILE("test");
-    const int ngrids = 10;
     Vector<Box> domains(ngrids);
     Vector<BoxArray> grids(ngrids);
 
@@ -42,6 +52,108 @@ void test ()
     }
 }
 
+//
+// Times the BoxList operations used in regridding on synthetic grids of
+// increasing size, and checks that they all cover the expected cells.
+//
+void scaling ()
+{
+    BL_PROFILE("scaling");
+
+    ParmParse pp;
+    int n_cell = 1024;
+    int box_size = 8;
+    Vector<int> nboxes{1000, 10000, 100000};
+    pp.query("n_cell", n_cell);
+    pp.query("box_size", box_size);
+    pp.queryarr("nboxes", nboxes);
+
+    const Box domain(IntVect(0), IntVect(n_cell-1));
+    const Long domain_pts = domain.numPts();
+
+    for (int nb : nboxes)
+    {
+        const BoxArray ba = makeClusteredBoxes(domain, box_size, nb);
+        const Long ba_pts = ba.numPts();
+        amrex::Print() << "nboxes " << ba.size() << ", domain " << domain << "\n";
+
+        Real t0 = amrex::second();
+        BoxList cbl;
+        cbl.complementIn(domain, ba);
+        Real t1 = amrex::second();
+        amrex::Print() << "    complementIn:         " << t1-t0 << " s, "
+                       << cbl.size() << " boxes\n";
+        AMREX_ALWAYS_ASSERT(BoxArray(cbl).numPts() + ba_pts == domain_pts);
+
+        t0 = amrex::second();
+        BoxList pbl;
+        pbl.parallelComplementIn(domain, ba);
+        t1 = amrex::second();
+        amrex::Print() << "    parallelComplementIn: " << t1-t0 << " s, "
+                       << pbl.size() << " boxes\n";
+        AMREX_ALWAYS_ASSERT(BoxArray(pbl).numPts() + ba_pts == domain_pts);
+
+        for (int best = 0; best < 2; ++best)
+        {
+            BoxList sbl = cbl;
+            t0 = amrex::second();
+            sbl.simplify(best);
+            t1 = amrex::second();
+            amrex::Print() << "    simplify(" << (best ? "true) " : "false)") << ":     "
+                           << t1-t0 << " s, " << sbl.size() << " boxes\n";
+            AMREX_ALWAYS_ASSERT(BoxArray(sbl).numPts() + ba_pts == domain_pts);
+        }
+
+        BoxList ibl(domain);
+        ibl.maxSize(64);
+        t0 = amrex::second();
+        ibl.intersect(ba.boxList());
+        t1 = amrex::second();
+        amrex::Print() << "    intersect:            " << t1-t0 << " s, "
+                       << ibl.size() << " boxes\n\n";
+        AMREX_ALWAYS_ASSERT(BoxArray(ibl).numPts() == ba_pts);
+    }
+}
+
+//
+// Returns at least nboxes disjoint boxes of size box_size, grouped in
+// balls of random radius and position, like the grids a tagging
+// criterion produces around features of the solution.
+//
+BoxArray
+makeClusteredBoxes (const Box& domain, int box_size, int nboxes)
+{
+    const Box cdomain = amrex::coarsen(domain, box_size);
+    const Long nmax = cdomain.numPts();
+    nboxes = static_cast<int>(std::min(static_cast<Long>(nboxes), nmax));
+
+    amrex::InitRandom(1);
+
+    std::vector<char> used(nmax, 0);
+    BoxList bl;
+    bl.reserve(nboxes);
+    while (static_cast<int>(bl.size()) < nboxes)
+    {
+        IntVect center;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            center[idim] = cdomain.smallEnd(idim) + amrex::Random_int(cdomain.length(idim));
+        }
+        const int r = 1 + amrex::Random_int(6);
+        const Box ball = amrex::grow(Box(center,center), r) & cdomain;
+        for (IntVect iv = ball.smallEnd(); iv <= ball.bigEnd(); ball.next(iv))
+        {
+            const IntVect d = iv - center;
+            if (AMREX_D_TERM(d[0]*d[0], + d[1]*d[1], + d[2]*d[2]) > r*r) continue;
+            const Long i = cdomain.index(iv);
+            if (used[i]) continue;
+            used[i] = 1;
+            bl.push_back(amrex::refine(Box(iv,iv), box_size));
+        }
+    }
+
+    return BoxArray(bl);
+}
+
 BoxArray
 readBoxList (const std::string& file, Box& domain)
 {